@@ -61,17 +61,24 @@ LOCAL_SRC_FILES := \
     src/waffle/core/wcore_tinfo.c \
     src/waffle/core/wcore_config_attrs.c \
     src/waffle/core/wcore_error.c \
+    src/waffle/core/wcore_extension_string.c \
+    src/waffle/core/wcore_extensions.c \
     src/waffle/core/wcore_util.c \
     src/waffle/core/wcore_display.c \
     src/waffle/core/wcore_attrib_list.c \
+    src/waffle/core/wcore_gl_fence.c \
+    src/waffle/core/wcore_proc_cache.c \
     src/waffle/api/api_priv.c \
     src/waffle/api/waffle_attrib_list.c \
     src/waffle/api/waffle_config.c \
     src/waffle/api/waffle_context.c \
+    src/waffle/api/waffle_device.c \
     src/waffle/api/waffle_display.c \
     src/waffle/api/waffle_enum.c \
     src/waffle/api/waffle_error.c \
+    src/waffle/api/waffle_fence.c \
     src/waffle/api/waffle_gl_misc.c \
+    src/waffle/api/waffle_image.c \
     src/waffle/api/waffle_init.c \
     src/waffle/api/waffle_window.c \
     src/waffle/api/waffle_dl.c \
@@ -80,6 +87,8 @@ LOCAL_SRC_FILES := \
     src/waffle/egl/wegl_config.c \
     src/waffle/egl/wegl_context.c \
     src/waffle/egl/wegl_display.c \
+    src/waffle/egl/wegl_fence.c \
+    src/waffle/egl/wegl_image.c \
     src/waffle/egl/wegl_platform.c \
     src/waffle/egl/wegl_util.c \
     src/waffle/egl/wegl_window.c \
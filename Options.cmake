@@ -5,7 +5,8 @@ if(waffle_on_linux)
         set(glx_default OFF)
     endif()
 
-    if(wayland-client_FOUND AND wayland-egl_FOUND AND egl_FOUND)
+    if(wayland-client_FOUND AND wayland-egl_FOUND AND egl_FOUND AND
+       wayland-scanner_FOUND AND wayland-protocols_FOUND)
         set(wayland_default ON)
     else()
         set(wayland_default OFF)
@@ -23,11 +24,25 @@ if(waffle_on_linux)
         set(gbm_default OFF)
     endif()
 
+    if(egl_FOUND)
+        set(surfaceless_egl_default ON)
+    else()
+        set(surfaceless_egl_default OFF)
+    endif()
+
+    if(egl_FOUND)
+        set(egl_device_default ON)
+    else()
+        set(egl_device_default OFF)
+    endif()
+
     # On Linux, you must enable at least one of the below options.
     option(waffle_has_glx "Build support for GLX" ${glx_default})
     option(waffle_has_wayland "Build support for Wayland" ${wayland_default})
     option(waffle_has_x11_egl "Build support for X11/EGL" ${x11_egl_default})
     option(waffle_has_gbm "Build support for GBM" ${gbm_default})
+    option(waffle_has_surfaceless_egl "Build support for EGL_MESA_platform_surfaceless" ${surfaceless_egl_default})
+    option(waffle_has_egl_device "Build support for EGL_EXT_platform_device" ${egl_device_default})
     option(waffle_has_nacl "Build support for NaCl" OFF)
 
     # NaCl specific settings.
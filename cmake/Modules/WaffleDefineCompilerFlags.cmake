@@ -108,16 +108,35 @@ if(waffle_on_linux)
 
     if(waffle_has_wayland)
         add_definitions(-DWAFFLE_HAS_WAYLAND)
+
+        # Protocol code generated by wayland-scanner >= 1.20, including the
+        # wayland-client headers of that release, calls wl_proxy_marshal_flags.
+        if(NOT wayland-client_VERSION VERSION_LESS 1.20 OR
+           NOT wayland-scanner_VERSION VERSION_LESS 1.20)
+            add_definitions(-DWAFFLE_WAYLAND_NEEDS_MARSHAL_FLAGS)
+        endif()
     endif()
 
     if(waffle_has_x11_egl)
         add_definitions(-DWAFFLE_HAS_X11_EGL)
     endif()
 
+    if(waffle_has_xcb_present)
+        add_definitions(-DWAFFLE_HAS_XCB_PRESENT)
+    endif()
+
     if(waffle_has_gbm)
         add_definitions(-DWAFFLE_HAS_GBM)
     endif()
 
+    if(waffle_has_surfaceless_egl)
+        add_definitions(-DWAFFLE_HAS_SURFACELESS_EGL)
+    endif()
+
+    if(waffle_has_egl_device)
+        add_definitions(-DWAFFLE_HAS_EGL_DEVICE)
+    endif()
+
     if(waffle_has_tls)
         add_definitions(-DWAFFLE_HAS_TLS)
     endif()
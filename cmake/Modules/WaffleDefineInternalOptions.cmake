@@ -1,6 +1,7 @@
-if(waffle_has_wayland OR waffle_has_x11_egl OR waffle_has_gbm)
+if(waffle_has_wayland OR waffle_has_x11_egl OR waffle_has_gbm OR
+   waffle_has_surfaceless_egl OR waffle_has_egl_device)
     set(waffle_has_egl TRUE)
-else(waffle_has_wayland OR waffle_has_x11_egl)
+else()
     set(waffle_has_egl FALSE)
 endif()
 
@@ -9,3 +10,10 @@ if(waffle_has_glx OR waffle_has_x11_egl)
 else()
     set(waffle_has_x11 FALSE)
 endif()
+
+# Optional: without it, x11 windows lack frame timing.
+if(waffle_has_x11 AND xcb-present_FOUND)
+    set(waffle_has_xcb_present TRUE)
+else()
+    set(waffle_has_xcb_present FALSE)
+endif()
@@ -72,12 +72,32 @@ if(waffle_on_linux)
     # waffle_has_wayland
     waffle_pkg_config(wayland-client wayland-client>=1)
     waffle_pkg_config(wayland-egl wayland-egl>=9.1)
+    waffle_pkg_config(wayland-scanner wayland-scanner)
+    waffle_pkg_config(wayland-protocols wayland-protocols>=1.12)
+
+    if(wayland-scanner_FOUND)
+        execute_process(
+            COMMAND ${PKG_CONFIG_EXECUTABLE} --variable=wayland_scanner wayland-scanner
+            OUTPUT_VARIABLE wayland_scanner
+            OUTPUT_STRIP_TRAILING_WHITESPACE
+            )
+    endif()
+
+    if(wayland-protocols_FOUND)
+        execute_process(
+            COMMAND ${PKG_CONFIG_EXECUTABLE} --variable=pkgdatadir wayland-protocols
+            OUTPUT_VARIABLE wayland-protocols_PKGDATADIR
+            OUTPUT_STRIP_TRAILING_WHITESPACE
+            )
+    endif()
 
     # waffle_has_x11
     waffle_pkg_config(x11-xcb x11-xcb)
+    waffle_pkg_config(xcb-present xcb-present)
 
     # waffle_has_gbm
     waffle_pkg_config(gbm gbm)
+    waffle_pkg_config(libdrm libdrm)
     waffle_pkg_config(libudev libudev)
 endif()
 
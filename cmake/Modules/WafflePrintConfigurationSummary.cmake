@@ -47,6 +47,12 @@ endif()
 if(waffle_has_gbm)
     message("    gbm")
 endif()
+if(waffle_has_surfaceless_egl)
+    message("    surfaceless_egl")
+endif()
+if(waffle_has_egl_device)
+    message("    egl_device")
+endif()
 if(waffle_on_windows)
     message("    wgl")
 endif()
@@ -61,13 +67,18 @@ endif()
 if(waffle_has_wayland)
     message("    wayland-client_INCLUDE_DIRS: ${wayland-client_INCLUDE_DIRS}")
     message("    wayland-egl_INCLUDE_DIRS:    ${wayland-egl_INCLUDE_DIRS}")
+    message("    wayland-protocols_PKGDATADIR: ${wayland-protocols_PKGDATADIR}")
 endif()
 if(waffle_has_x11)
     message("    x11-xcb_INCLUDE_DIRS: ${x11-xcb_INCLUDE_DIRS}")
     message("    x11-xcb_LDFLAGS:      ${x11-xcb_LDFLAGS}")
 endif()
+if(waffle_has_xcb_present)
+    message("    xcb-present_LDFLAGS:  ${xcb-present_LDFLAGS}")
+endif()
 if(waffle_has_gbm)
     message("    gbm_INCLUDE_DIRS: ${gbm_INCLUDE_DIRS}")
+    message("    libdrm_INCLUDE_DIRS: ${libdrm_INCLUDE_DIRS}")
 endif()
 message("")
 message("Build type:")
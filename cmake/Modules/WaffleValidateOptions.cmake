@@ -47,11 +47,13 @@ endif()
 if(waffle_on_linux)
     if(NOT waffle_has_glx AND NOT waffle_has_wayland AND
        NOT waffle_has_x11_egl AND NOT waffle_has_gbm AND
+       NOT waffle_has_surfaceless_egl AND NOT waffle_has_egl_device AND
        NOT waffle_has_nacl)
         message(FATAL_ERROR
                 "Must enable at least one of: "
                 "waffle_has_glx, waffle_has_wayland, "
                 "waffle_has_x11_egl, waffle_has_gbm, "
+                "waffle_has_surfaceless_egl, waffle_has_egl_device, "
                 "waffle_has_nacl.")
     endif()
     if(waffle_has_nacl)
@@ -73,6 +75,8 @@ if(waffle_on_linux)
 
         # When building for NaCl, disable incompatible backends.
         set(waffle_has_gbm OFF)
+        set(waffle_has_surfaceless_egl OFF)
+        set(waffle_has_egl_device OFF)
         set(waffle_has_egl OFF)
         set(waffle_has_glx OFF)
         set(waffle_has_x11 OFF)
@@ -85,6 +89,11 @@ if(waffle_on_linux)
                 "${gbm_missing_deps} gbm"
                 )
         endif()
+        if(NOT libdrm_FOUND)
+            set(gbm_missing_deps
+                "${gbm_missing_deps} libdrm"
+                )
+        endif()
         if(NOT libudev_FOUND)
             set(gbm_missing_deps
                 "${gbm_missing_deps} libudev"
@@ -99,6 +108,16 @@ if(waffle_on_linux)
             message(FATAL_ERROR "gbm dependency is missing: ${gbm_missing_deps}")
         endif()
     endif()
+    if(waffle_has_surfaceless_egl)
+        if(NOT egl_FOUND)
+            message(FATAL_ERROR "surfaceless_egl dependency is missing: egl")
+        endif()
+    endif()
+    if(waffle_has_egl_device)
+        if(NOT egl_FOUND)
+            message(FATAL_ERROR "egl_device dependency is missing: egl")
+        endif()
+    endif()
     if(waffle_has_glx)
         if(NOT gl_FOUND)
             set(glx_missing_deps
@@ -125,6 +144,16 @@ if(waffle_on_linux)
                 "${wayland_missing_deps} wayland-egl>=9.1"
                 )
         endif()
+        if(NOT wayland-scanner_FOUND)
+            set(wayland_missing_deps
+                "${wayland_missing_deps} wayland-scanner"
+                )
+        endif()
+        if(NOT wayland-protocols_FOUND)
+            set(wayland_missing_deps
+                "${wayland_missing_deps} wayland-protocols>=1.12"
+                )
+        endif()
         if(NOT egl_FOUND)
             set(wayland_missing_deps
                 "${wayland_missing_deps} egl"
@@ -162,6 +191,12 @@ elseif(waffle_on_mac)
     if(waffle_has_x11_egl)
         message(FATAL_ERROR "Option is not supported on Darwin: waffle_has_x11_egl.")
     endif()
+    if(waffle_has_surfaceless_egl)
+        message(FATAL_ERROR "Option is not supported on Darwin: waffle_has_surfaceless_egl.")
+    endif()
+    if(waffle_has_egl_device)
+        message(FATAL_ERROR "Option is not supported on Darwin: waffle_has_egl_device.")
+    endif()
 elseif(waffle_on_windows)
     if(waffle_has_gbm)
         message(FATAL_ERROR "Option is not supported on Windows: waffle_has_gbm.")
@@ -175,4 +210,10 @@ elseif(waffle_on_windows)
     if(waffle_has_x11_egl)
         message(FATAL_ERROR "Option is not supported on Windows: waffle_has_x11_egl.")
     endif()
+    if(waffle_has_surfaceless_egl)
+        message(FATAL_ERROR "Option is not supported on Windows: waffle_has_surfaceless_egl.")
+    endif()
+    if(waffle_has_egl_device)
+        message(FATAL_ERROR "Option is not supported on Windows: waffle_has_egl_device.")
+    endif()
 endif()
@@ -61,7 +61,7 @@ removeXcodeArgs(int *argc, char **argv);
 
 static const char *usage_message =
     "usage:\n"
-    "    gl_basic --platform=android|cgl|gbm|glx|wayland|wgl|x11_egl\n"
+    "    gl_basic --platform=android|cgl|egl_device|gbm|glx|surfaceless_egl|wayland|wgl|x11_egl\n"
     "             --api=gl|gles1|gles2|gles3\n"
     "             [--version=MAJOR.MINOR]\n"
     "             [--profile=core|compat|none]\n"
@@ -248,8 +248,10 @@ struct enum_map {
 static const struct enum_map platform_map[] = {
     {WAFFLE_PLATFORM_ANDROID,   "android"       },
     {WAFFLE_PLATFORM_CGL,       "cgl",          },
+    {WAFFLE_PLATFORM_EGL_DEVICE, "egl_device"   },
     {WAFFLE_PLATFORM_GBM,       "gbm"           },
     {WAFFLE_PLATFORM_GLX,       "glx"           },
+    {WAFFLE_PLATFORM_SURFACELESS_EGL, "surfaceless_egl" },
     {WAFFLE_PLATFORM_WAYLAND,   "wayland"       },
     {WAFFLE_PLATFORM_WGL,       "wgl"           },
     {WAFFLE_PLATFORM_X11_EGL,   "x11_egl"       },
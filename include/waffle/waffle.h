@@ -119,6 +119,12 @@ enum waffle_enum {
         WAFFLE_PLATFORM_GBM                                     = 0x0016,
         WAFFLE_PLATFORM_WGL                                     = 0x0017,
         WAFFLE_PLATFORM_NACL                                    = 0x0018,
+#if WAFFLE_API_VERSION >= 0x0106
+        WAFFLE_PLATFORM_SURFACELESS_EGL                         = 0x0019,
+        WAFFLE_PLATFORM_EGL_DEVICE                              = 0x001a,
+
+    WAFFLE_MAKE_CURRENT_ELISION                                 = 0x0020,
+#endif
 
     // ------------------------------------------------------------------
     // For waffle_config_choose()
@@ -173,6 +179,23 @@ enum waffle_enum {
     WAFFLE_WINDOW_WIDTH                                         = 0x0310,
     WAFFLE_WINDOW_HEIGHT                                        = 0x0311,
     WAFFLE_WINDOW_FULLSCREEN                                    = 0x0312,
+#if WAFFLE_API_VERSION >= 0x0106
+    WAFFLE_WINDOW_OFFSCREEN                                     = 0x0313,
+    WAFFLE_WINDOW_WAYLAND_SYNC_SWAP                             = 0x0314,
+    WAFFLE_WINDOW_GBM_BUFFERS_IN_FLIGHT                         = 0x0315,
+    WAFFLE_WINDOW_GBM_MODIFIERS                                 = 0x0316,
+    WAFFLE_WINDOW_GBM_LINEAR                                    = 0x0317,
+    WAFFLE_WINDOW_GBM_KMS_OUTPUT                                = 0x0318,
+    WAFFLE_WINDOW_GBM_KMS_CONNECTOR                             = 0x0319,
+
+    // ------------------------------------------------------------------
+    // For waffle_device_query_string()
+    // ------------------------------------------------------------------
+
+    WAFFLE_DEVICE_EXTENSIONS                                    = 0x0320,
+    WAFFLE_DEVICE_DRM_FILE                                      = 0x0321,
+    WAFFLE_DEVICE_DRM_RENDER_NODE_FILE                          = 0x0322,
+#endif
 };
 
 const char*
@@ -193,6 +216,22 @@ waffle_make_current(struct waffle_display *dpy,
                     struct waffle_window *window,
                     struct waffle_context *ctx);
 
+#if WAFFLE_API_VERSION >= 0x0106
+// Counters of waffle_make_current() calls on the calling thread.
+struct waffle_make_current_stats {
+    uint64_t calls;
+
+    // Calls that asked for the binding that was already current.
+    uint64_t rebinds;
+
+    // Rebinds that returned without calling into the platform.
+    uint64_t elided;
+};
+
+bool
+waffle_get_make_current_stats(struct waffle_make_current_stats *stats);
+#endif
+
 void*
 waffle_get_proc_address(const char *name);
 
@@ -200,6 +239,29 @@ bool
 waffle_is_extension_in_string(const char *extension_string,
                               const char *extension_name);
 
+#if WAFFLE_API_VERSION >= 0x0106
+// Counters of the cache that waffle_get_proc_address() and waffle_dl_sym()
+// consult before asking the platform. Only successful lookups are cached.
+struct waffle_symbol_cache_stats {
+    uint64_t hits;
+    uint64_t misses;
+
+    // The number of distinct symbols in the cache.
+    uint32_t entries;
+};
+
+bool
+waffle_get_symbol_cache_stats(struct waffle_symbol_cache_stats *stats);
+
+// Look up count names at once, storing each result in procs. Names that are
+// not found get a null pointer and do not emit an error. Return the number of
+// names found, or -1 on error.
+int32_t
+waffle_get_proc_address_many(int32_t count,
+                             const char *const *names,
+                             void **procs);
+#endif
+
 // ---------------------------------------------------------------------------
 // waffle_display
 // ---------------------------------------------------------------------------
@@ -214,6 +276,13 @@ bool
 waffle_display_supports_context_api(struct waffle_display *self,
                                     int32_t context_api);
 
+#if WAFFLE_API_VERSION >= 0x0106
+// Test if the display's EGL, GLX or WGL extension string contains name.
+bool
+waffle_display_has_extension(struct waffle_display *self,
+                             const char *name);
+#endif
+
 union waffle_native_display*
 waffle_display_get_native(struct waffle_display *self);
 
@@ -274,6 +343,103 @@ waffle_window_swap_buffers(struct waffle_window *self);
 union waffle_native_window*
 waffle_window_get_native(struct waffle_window *self);
 
+#if WAFFLE_API_VERSION >= 0x0106
+// Timestamps are in nanoseconds, on the presentation clock of the platform,
+// which is CLOCK_MONOTONIC on Linux.
+struct waffle_frame_timing {
+    // The number of the swap, counting from 1, or 0 if no swap has been
+    // presented yet.
+    uint64_t frame;
+
+    // When waffle_window_swap_buffers() was called.
+    uint64_t submit_ns;
+
+    // When the frame was shown on the display.
+    uint64_t present_ns;
+
+    // The display's refresh interval, or 0 if unknown.
+    uint64_t refresh_ns;
+};
+
+bool
+waffle_window_get_frame_timing(
+        struct waffle_window *self,
+        struct waffle_frame_timing *timing);
+
+// Swap, hinting that only the given rectangles changed since the previous
+// swap. rects holds n_rects (x, y, width, height) quadruples, with the origin
+// at the lower left corner of the window. Where the platform cannot take the
+// hint, this is a plain waffle_window_swap_buffers().
+bool
+waffle_window_swap_buffers_with_damage(
+        struct waffle_window *self,
+        const int32_t *rects,
+        int32_t n_rects);
+
+// Get the number of swaps since the back buffer's contents were last
+// presented, or 0 if its contents are undefined.
+bool
+waffle_window_query_buffer_age(
+        struct waffle_window *self,
+        int32_t *age);
+
+// Restrict rendering until the next swap to the given rectangles, laid out
+// as for waffle_window_swap_buffers_with_damage(). Query the buffer age first.
+bool
+waffle_window_set_damage_region(
+        struct waffle_window *self,
+        const int32_t *rects,
+        int32_t n_rects);
+
+// Set the minimum number of video frames between buffer swaps. 0 disables
+// vsync; a negative interval requests adaptive vsync, where supported. The
+// window must be bound to the current context of the calling thread.
+bool
+waffle_window_set_swap_interval(
+        struct waffle_window *self,
+        int32_t interval);
+
+#define WAFFLE_FRAME_MAX_PLANES 4
+
+// A presented frame, exported as dma-buf file descriptors for zero-copy
+// consumers such as video encoders.
+struct waffle_frame {
+    uint32_t width;
+    uint32_t height;
+
+    // A DRM fourcc code.
+    uint32_t format;
+
+    // A DRM format modifier, or DRM_FORMAT_MOD_INVALID if the layout is
+    // implied by the driver.
+    uint64_t modifier;
+
+    int32_t num_planes;
+
+    // The descriptors are owned by waffle and are closed when the frame is
+    // released. dup() them to keep them longer.
+    int32_t fds[WAFFLE_FRAME_MAX_PLANES];
+    uint32_t strides[WAFFLE_FRAME_MAX_PLANES];
+    uint32_t offsets[WAFFLE_FRAME_MAX_PLANES];
+
+    // Private to waffle.
+    void *priv;
+};
+
+// Export the buffer presented by the most recent swap. The window renders
+// into its other buffers until the frame is released, so release frames
+// promptly or swapping will fail. Release them before destroying the window.
+bool
+waffle_window_acquire_frame(
+        struct waffle_window *self,
+        struct waffle_frame *frame);
+
+bool
+waffle_window_release_frame(
+        struct waffle_window *self,
+        struct waffle_frame *frame);
+#endif
+
 #if defined(WAFFLE_API_EXPERIMENTAL) && WAFFLE_API_VERSION >= 0x0103
 bool
 waffle_window_resize(
@@ -282,6 +448,66 @@ waffle_window_resize(
         int32_t height);
 #endif
 
+// ---------------------------------------------------------------------------
+// waffle_fence
+// ---------------------------------------------------------------------------
+
+#if WAFFLE_API_VERSION >= 0x0106
+struct waffle_fence;
+
+// Pass as timeout_ns to wait until the fence is signaled.
+#define WAFFLE_FENCE_TIMEOUT_INFINITE (~(uint64_t) 0)
+
+// Insert a fence into the command stream of the current context, which must
+// belong to dpy.
+struct waffle_fence*
+waffle_fence_create(struct waffle_display *dpy);
+
+bool
+waffle_fence_destroy(struct waffle_fence *self);
+
+// Block until the fence is signaled or timeout_ns elapses. On success,
+// signaled tells which happened.
+bool
+waffle_fence_client_wait(struct waffle_fence *self,
+                         uint64_t timeout_ns,
+                         bool *signaled);
+
+// Make the current context wait on the GPU for the fence, without blocking
+// the calling thread.
+bool
+waffle_fence_server_wait(struct waffle_fence *self);
+#endif
+
+// ---------------------------------------------------------------------------
+// waffle_image
+// ---------------------------------------------------------------------------
+
+#if WAFFLE_API_VERSION >= 0x0106
+struct waffle_image;
+
+// Wrap a level of a 2D texture of ctx, which must be current, so that other
+// contexts of the display can sample it without a copy.
+struct waffle_image*
+waffle_image_create_from_texture(struct waffle_context *ctx,
+                                 uint32_t texture,
+                                 int32_t level);
+
+// Likewise, for a renderbuffer of ctx.
+struct waffle_image*
+waffle_image_create_from_renderbuffer(struct waffle_context *ctx,
+                                      uint32_t renderbuffer);
+
+bool
+waffle_image_destroy(struct waffle_image *self);
+
+// Make the image the storage of the texture bound to target, typically
+// GL_TEXTURE_2D, in the current context.
+bool
+waffle_image_bind_texture(struct waffle_image *self,
+                          uint32_t target);
+#endif
+
 // ---------------------------------------------------------------------------
 // waffle_dl
 // ---------------------------------------------------------------------------
@@ -292,10 +518,41 @@ waffle_dl_can_open(int32_t dl);
 void*
 waffle_dl_sym(int32_t dl, const char *name);
 
+#if WAFFLE_API_VERSION >= 0x0106
+// Waffle remembers libraries that failed to open. Forget them, so that the
+// next call to waffle_dl_can_open() or waffle_dl_sym() searches again.
+bool
+waffle_dl_rescan(void);
+
+// Batch variant of waffle_dl_sym(), with the same conventions as
+// waffle_get_proc_address_many().
+int32_t
+waffle_dl_sym_many(int32_t dl,
+                   int32_t count,
+                   const char *const *names,
+                   void **syms);
+#endif
+
+// ---------------------------------------------------------------------------
+// waffle_device
+// ---------------------------------------------------------------------------
+
+#if WAFFLE_API_VERSION >= 0x0106
+int32_t
+waffle_enumerate_devices(void);
+
+const char*
+waffle_device_query_string(int32_t device, int32_t name);
+#endif
+
 // ---------------------------------------------------------------------------
 // waffle_native
 // ---------------------------------------------------------------------------
 
+struct waffle_egl_device_config;
+struct waffle_egl_device_context;
+struct waffle_egl_device_display;
+struct waffle_egl_device_window;
 struct waffle_gbm_config;
 struct waffle_gbm_context;
 struct waffle_gbm_display;
@@ -304,6 +561,10 @@ struct waffle_glx_config;
 struct waffle_glx_context;
 struct waffle_glx_display;
 struct waffle_glx_window;
+struct waffle_surfaceless_egl_config;
+struct waffle_surfaceless_egl_context;
+struct waffle_surfaceless_egl_display;
+struct waffle_surfaceless_egl_window;
 struct waffle_wayland_config;
 struct waffle_wayland_context;
 struct waffle_wayland_display;
@@ -318,6 +579,8 @@ union waffle_native_display {
     struct waffle_glx_display *glx;
     struct waffle_x11_egl_display *x11_egl;
     struct waffle_wayland_display *wayland;
+    struct waffle_surfaceless_egl_display *surfaceless_egl;
+    struct waffle_egl_device_display *egl_device;
 };
 
 union waffle_native_config {
@@ -325,6 +588,8 @@ union waffle_native_config {
     struct waffle_glx_config *glx;
     struct waffle_x11_egl_config *x11_egl;
     struct waffle_wayland_config *wayland;
+    struct waffle_surfaceless_egl_config *surfaceless_egl;
+    struct waffle_egl_device_config *egl_device;
 };
 
 union waffle_native_context {
@@ -332,6 +597,8 @@ union waffle_native_context {
     struct waffle_glx_context *glx;
     struct waffle_x11_egl_context *x11_egl;
     struct waffle_wayland_context *wayland;
+    struct waffle_surfaceless_egl_context *surfaceless_egl;
+    struct waffle_egl_device_context *egl_device;
 };
 
 union waffle_native_window {
@@ -339,6 +606,8 @@ union waffle_native_window {
     struct waffle_glx_window *glx;
     struct waffle_x11_egl_window *x11_egl;
     struct waffle_wayland_window *wayland;
+    struct waffle_surfaceless_egl_window *surfaceless_egl;
+    struct waffle_egl_device_window *egl_device;
 };
 
 // ---------------------------------------------------------------------------
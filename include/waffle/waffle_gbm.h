@@ -38,6 +38,7 @@ extern "C" {
 
 struct gbm_device;
 struct gbm_surface;
+struct waffle_window;
 
 struct waffle_gbm_display {
     struct gbm_device *gbm_device;
@@ -60,6 +61,36 @@ struct waffle_gbm_window {
     EGLSurface egl_surface;
 };
 
+#if WAFFLE_API_VERSION >= 0x0106
+// A CPU mapping of the buffer presented by a GBM window's most recent swap.
+struct waffle_gbm_mapped_buffer {
+    void *data;
+    uint32_t width;
+    uint32_t height;
+    uint32_t stride;
+
+    // A DRM fourcc code.
+    uint32_t format;
+
+    // Private to waffle.
+    void *priv;
+    void *map_data;
+};
+
+// Map the window's front buffer for reading. As with
+// waffle_window_acquire_frame(), the window does not render into the buffer
+// until it is unmapped, and cannot be destroyed while it is mapped.
+bool
+waffle_gbm_window_map_front_buffer(
+        struct waffle_window *window,
+        struct waffle_gbm_mapped_buffer *buffer);
+
+bool
+waffle_gbm_window_unmap_front_buffer(
+        struct waffle_window *window,
+        struct waffle_gbm_mapped_buffer *buffer);
+#endif
+
 #ifdef __cplusplus
 } // end extern "C"
 #endif
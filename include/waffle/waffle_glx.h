@@ -51,6 +51,7 @@ struct waffle_glx_context {
 struct waffle_glx_window {
     Display *xlib_display;
     XID xlib_window;
+    GLXPbuffer glx_pbuffer;
 };
 
 #ifdef __cplusplus
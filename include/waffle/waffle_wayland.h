@@ -42,12 +42,16 @@ struct wl_egl_window;
 struct wl_shell;
 struct wl_shell_surface;
 struct wl_surface;
+struct xdg_surface;
+struct xdg_toplevel;
+struct xdg_wm_base;
 
 struct waffle_wayland_display {
     struct wl_display *wl_display;
     struct wl_compositor *wl_compositor;
     struct wl_shell *wl_shell;
     EGLDisplay egl_display;
+    struct xdg_wm_base *xdg_wm_base;
 };
 
 struct waffle_wayland_config {
@@ -66,6 +70,8 @@ struct waffle_wayland_window {
     struct wl_shell_surface *wl_shell_surface;
     struct wl_egl_window *wl_window;
     EGLSurface egl_surface;
+    struct xdg_surface *xdg_surface;
+    struct xdg_toplevel *xdg_toplevel;
 };
 
 #ifdef __cplusplus
@@ -35,12 +35,15 @@ set(man_outputs
     ${man_out_dir}/man3/waffle_config.3
     ${man_out_dir}/man3/waffle_context.3
     ${man_out_dir}/man3/waffle_display.3
+    ${man_out_dir}/man3/waffle_device.3
     ${man_out_dir}/man3/waffle_dl.3
     ${man_out_dir}/man3/waffle_enum.3
     ${man_out_dir}/man3/waffle_error.3
+    ${man_out_dir}/man3/waffle_fence.3
     ${man_out_dir}/man3/waffle_gbm.3
     ${man_out_dir}/man3/waffle_get_proc_address.3
     ${man_out_dir}/man3/waffle_glx.3
+    ${man_out_dir}/man3/waffle_image.3
     ${man_out_dir}/man3/waffle_init.3
     ${man_out_dir}/man3/waffle_is_extension_in_string.3
     ${man_out_dir}/man3/waffle_make_current.3
@@ -71,13 +74,16 @@ waffle_add_manpage(1 wflinfo)
 waffle_add_manpage(3 waffle_attrib_list)
 waffle_add_manpage(3 waffle_config)
 waffle_add_manpage(3 waffle_context)
+waffle_add_manpage(3 waffle_device)
 waffle_add_manpage(3 waffle_display)
 waffle_add_manpage(3 waffle_dl)
 waffle_add_manpage(3 waffle_enum)
 waffle_add_manpage(3 waffle_error)
+waffle_add_manpage(3 waffle_fence)
 waffle_add_manpage(3 waffle_gbm)
 waffle_add_manpage(3 waffle_get_proc_address)
 waffle_add_manpage(3 waffle_glx)
+waffle_add_manpage(3 waffle_image)
 waffle_add_manpage(3 waffle_init)
 waffle_add_manpage(3 waffle_is_extension_in_string)
 waffle_add_manpage(3 waffle_make_current)
@@ -62,7 +62,8 @@ static const char *usage_message =
     "\n"
     "Required Parameters:\n"
     "    -p, --platform\n"
-    "        One of: android, cgl, gbm, glx, wayland, wgl or x11_egl\n"
+    "        One of: android, cgl, egl_device, gbm, glx, surfaceless_egl,\n"
+    "        wayland, wgl or x11_egl\n"
     "\n"
     "    -a, --api\n"
     "        One of: gl, gles1, gles2 or gles3\n"
@@ -265,8 +266,10 @@ struct enum_map {
 static const struct enum_map platform_map[] = {
     {WAFFLE_PLATFORM_ANDROID,   "android"       },
     {WAFFLE_PLATFORM_CGL,       "cgl",          },
+    {WAFFLE_PLATFORM_EGL_DEVICE, "egl_device"   },
     {WAFFLE_PLATFORM_GBM,       "gbm"           },
     {WAFFLE_PLATFORM_GLX,       "glx"           },
+    {WAFFLE_PLATFORM_SURFACELESS_EGL, "surfaceless_egl" },
     {WAFFLE_PLATFORM_WAYLAND,   "wayland"       },
     {WAFFLE_PLATFORM_WGL,       "wgl"           },
     {WAFFLE_PLATFORM_X11_EGL,   "x11_egl"       },
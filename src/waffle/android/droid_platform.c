@@ -32,6 +32,8 @@
 
 #include "wegl_config.h"
 #include "wegl_context.h"
+#include "wegl_fence.h"
+#include "wegl_image.h"
 #include "wegl_util.h"
 
 #include "droid_display.h"
@@ -102,6 +104,24 @@ droid_dl_sym(
                                  waffle_dl, name);
 }
 
+static int32_t
+droid_dl_sym_many(
+        struct wcore_platform *wc_self,
+        int32_t waffle_dl,
+        int32_t count,
+        const char *const *names,
+        void **syms)
+{
+    return linux_platform_dl_sym_many(droid_platform(wc_self)->linux,
+                                      waffle_dl, count, names, syms);
+}
+
+static void
+droid_dl_rescan(struct wcore_platform *wc_self)
+{
+    linux_platform_dl_rescan(droid_platform(wc_self)->linux);
+}
+
 static const struct wcore_platform_vtbl droid_platform_vtbl = {
     .destroy = droid_platform_destroy,
 
@@ -109,6 +129,8 @@ static const struct wcore_platform_vtbl droid_platform_vtbl = {
     .get_proc_address = wegl_get_proc_address,
     .dl_can_open = droid_dl_can_open,
     .dl_sym = droid_dl_sym,
+    .dl_sym_many = droid_dl_sym_many,
+    .dl_rescan = droid_dl_rescan,
 
     .display = {
         .connect = droid_display_connect,
@@ -134,7 +156,25 @@ static const struct wcore_platform_vtbl droid_platform_vtbl = {
         .destroy = droid_window_destroy,
         .show = droid_window_show,
         .swap_buffers = wegl_window_swap_buffers,
+        .swap_buffers_with_damage = wegl_window_swap_buffers_with_damage,
         .resize = droid_window_resize,
+        .query_buffer_age = wegl_window_query_buffer_age,
+        .set_damage_region = wegl_window_set_damage_region,
+        .set_swap_interval = wegl_window_set_swap_interval,
         .get_native = NULL,
     },
+
+    .fence = {
+        .create = wegl_fence_create,
+        .destroy = wegl_fence_destroy,
+        .client_wait = wegl_fence_client_wait,
+        .server_wait = wegl_fence_server_wait,
+    },
+
+    .image = {
+        .create_from_texture = wegl_image_create_from_texture,
+        .create_from_renderbuffer = wegl_image_create_from_renderbuffer,
+        .destroy = wegl_image_destroy,
+        .bind_texture = wegl_image_bind_texture,
+    },
 };
@@ -28,6 +28,7 @@
 #include "wcore_context.h"
 #include "wcore_error.h"
 #include "wcore_platform.h"
+#include "wcore_tinfo.h"
 
 WAFFLE_API struct waffle_context*
 waffle_context_create(
@@ -69,6 +70,7 @@ waffle_context_destroy(struct waffle_context *self)
     if (!api_check_entry(obj_list, 1))
         return false;
 
+    wcore_tinfo_invalidate_bindings();
     return api_platform->vtbl->context.destroy(wc_self);
 }
 
@@ -0,0 +1,69 @@
+// Copyright 2016 Google
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "api_priv.h"
+
+#include "wcore_error.h"
+#include "wcore_platform.h"
+
+WAFFLE_API int32_t
+waffle_enumerate_devices(void)
+{
+    if (!api_check_entry(NULL, 0))
+        return -1;
+
+    if (!api_platform->vtbl->enumerate_devices) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return -1;
+    }
+
+    return api_platform->vtbl->enumerate_devices(api_platform);
+}
+
+WAFFLE_API const char*
+waffle_device_query_string(int32_t device, int32_t name)
+{
+    if (!api_check_entry(NULL, 0))
+        return NULL;
+
+    switch (name) {
+        case WAFFLE_DEVICE_EXTENSIONS:
+        case WAFFLE_DEVICE_DRM_FILE:
+        case WAFFLE_DEVICE_DRM_RENDER_NODE_FILE:
+            break;
+        default:
+            wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                         "name has bad value %#x", name);
+            return NULL;
+    }
+
+    if (!api_platform->vtbl->device_query_string) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return NULL;
+    }
+
+    return api_platform->vtbl->device_query_string(api_platform, device,
+                                                   name);
+}
@@ -28,6 +28,7 @@
 #include "wcore_error.h"
 #include "wcore_display.h"
 #include "wcore_platform.h"
+#include "wcore_tinfo.h"
 #include "wcore_util.h"
 
 WAFFLE_API struct waffle_display*
@@ -57,6 +58,7 @@ waffle_display_disconnect(struct waffle_display *self)
     if (!api_check_entry(obj_list, 1))
         return false;
 
+    wcore_tinfo_invalidate_bindings();
     return api_platform->vtbl->display.destroy(wc_self);
 }
 
@@ -90,6 +92,34 @@ waffle_display_supports_context_api(
                                                             context_api);
 }
 
+WAFFLE_API bool
+waffle_display_has_extension(
+        struct waffle_display *self,
+        const char *name)
+{
+    struct wcore_display *wc_self = wcore_display(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    if (!name) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "name is null");
+        return false;
+    }
+
+    if (!wc_self->extensions) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "platform does not report display extensions");
+        return false;
+    }
+
+    return wcore_display_has_extension(wc_self, name);
+}
+
 WAFFLE_API union waffle_native_display*
 waffle_display_get_native(struct waffle_display *self)
 {
@@ -27,6 +27,8 @@
 
 #include "wcore_error.h"
 #include "wcore_platform.h"
+#include "wcore_proc_cache.h"
+#include "wcore_util.h"
 
 static bool
 waffle_dl_check_enum(int32_t dl)
@@ -55,14 +57,88 @@ waffle_dl_can_open(int32_t dl)
      return api_platform->vtbl->dl_can_open(api_platform, dl);
 }
 
+WAFFLE_API bool
+waffle_dl_rescan(void)
+{
+    if (!api_check_entry(NULL, 0))
+        return false;
+
+    if (api_platform->vtbl->dl_rescan)
+        api_platform->vtbl->dl_rescan(api_platform);
+
+    return true;
+}
+
 WAFFLE_API void*
 waffle_dl_sym(int32_t dl, const char *name)
 {
+    void *sym;
+
     if (!api_check_entry(NULL, 0))
         return NULL;
 
     if (!waffle_dl_check_enum(dl))
         return NULL;
 
-    return api_platform->vtbl->dl_sym(api_platform, dl, name);
+    if (wcore_proc_cache_lookup(api_platform->proc_cache, dl, name, &sym))
+        return sym;
+
+    sym = api_platform->vtbl->dl_sym(api_platform, dl, name);
+    wcore_proc_cache_insert(api_platform->proc_cache, dl, name, sym);
+    return sym;
+}
+
+WAFFLE_API int32_t
+waffle_dl_sym_many(int32_t dl,
+                   int32_t count,
+                   const char *const *names,
+                   void **syms)
+{
+    struct wcore_proc_cache *cache;
+    int32_t found;
+
+    if (!api_check_entry(NULL, 0))
+        return -1;
+
+    if (!waffle_dl_check_enum(dl))
+        return -1;
+
+    if (count < 0 || (count > 0 && (!names || !syms))) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "bad symbol array (count=%d)", count);
+        return -1;
+    }
+
+    cache = api_platform->proc_cache;
+    found = wcore_proc_cache_lookup_many(cache, dl, count, names, syms);
+    if (found == count)
+        return found;
+
+    if (api_platform->vtbl->dl_sym_many) {
+        found = api_platform->vtbl->dl_sym_many(api_platform, dl, count,
+                                                names, syms);
+        if (found < 0)
+            return -1;
+    } else {
+        if (!api_platform->vtbl->dl_can_open(api_platform, dl)) {
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN, "failed to open the library "
+                         "for %s", wcore_enum_to_string(dl));
+            return -1;
+        }
+
+        found = 0;
+        for (int32_t i = 0; i < count; ++i) {
+            if (!syms[i] && names[i]) {
+                WCORE_ERROR_DISABLED({
+                    syms[i] = api_platform->vtbl->dl_sym(api_platform, dl,
+                                                         names[i]);
+                });
+            }
+            if (syms[i])
+                found++;
+        }
+    }
+
+    wcore_proc_cache_insert_many(cache, dl, count, names, syms);
+    return found;
 }
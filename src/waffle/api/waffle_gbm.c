@@ -0,0 +1,86 @@
+// Copyright 2016 Google
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "waffle_gbm.h"
+
+#include "api_priv.h"
+
+#include "wcore_error.h"
+#include "wcore_platform.h"
+#include "wcore_window.h"
+
+WAFFLE_API bool
+waffle_gbm_window_map_front_buffer(
+        struct waffle_window *window,
+        struct waffle_gbm_mapped_buffer *buffer)
+{
+    struct wcore_window *wc_window = wcore_window(window);
+
+    const struct api_object *obj_list[] = {
+        wc_window ? &wc_window->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    if (!buffer) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "buffer is null");
+        return false;
+    }
+
+    if (!api_platform->vtbl->window.map_front_buffer) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return false;
+    }
+
+    return api_platform->vtbl->window.map_front_buffer(wc_window, buffer);
+}
+
+WAFFLE_API bool
+waffle_gbm_window_unmap_front_buffer(
+        struct waffle_window *window,
+        struct waffle_gbm_mapped_buffer *buffer)
+{
+    struct wcore_window *wc_window = wcore_window(window);
+
+    const struct api_object *obj_list[] = {
+        wc_window ? &wc_window->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    if (!buffer || !buffer->priv) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "buffer was not mapped");
+        return false;
+    }
+
+    if (!api_platform->vtbl->window.unmap_front_buffer) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return false;
+    }
+
+    return api_platform->vtbl->window.unmap_front_buffer(wc_window, buffer);
+}
@@ -32,7 +32,10 @@
 #include "wcore_context.h"
 #include "wcore_display.h"
 #include "wcore_error.h"
+#include "wcore_extension_string.h"
 #include "wcore_platform.h"
+#include "wcore_proc_cache.h"
+#include "wcore_tinfo.h"
 #include "wcore_window.h"
 
 WAFFLE_API bool
@@ -41,7 +44,6 @@ waffle_is_extension_in_string(
         const char *restrict extension_name)
 {
     size_t name_length;
-    const char *restrict search_start;
 
     wcore_error_reset();
 
@@ -49,27 +51,11 @@ waffle_is_extension_in_string(
         return false;
 
     name_length = strlen(extension_name);
-    search_start = extension_string;
-
     if (name_length == 0)
         return false;
 
-    while (true) {
-        const char *restrict s;
-        const char *restrict next_char;
-
-        s = strstr(search_start, extension_name);
-        if (s == NULL)
-            return false;
-
-        next_char = s + name_length;
-        if (*next_char == ' ' || *next_char == '\0')
-            return true;
-
-        // strstr found an extension whose name begins with, but is not
-        // equal to, extension_name. Continue the search
-        search_start = next_char;
-    }
+    return wcore_extension_in_string(extension_string, extension_name,
+                                     name_length);
 }
 
 WAFFLE_API bool
@@ -81,6 +67,10 @@ waffle_make_current(
     struct wcore_display *wc_dpy = wcore_display(dpy);
     struct wcore_window *wc_window = wcore_window(window);
     struct wcore_context *wc_ctx = wcore_context(ctx);
+    struct wcore_tinfo *tinfo;
+    struct wcore_tinfo_binding *binding;
+    uint32_t epoch;
+    bool ok;
 
     const struct api_object *obj_list[3];
     int len = 0;
@@ -94,17 +84,140 @@ waffle_make_current(
     if (!api_check_entry(obj_list, len))
         return false;
 
-    return api_platform->vtbl->make_current(api_platform,
-                                            wc_dpy,
-                                            wc_window,
-                                            wc_ctx);
+    tinfo = wcore_tinfo_get();
+    binding = &tinfo->binding;
+    tinfo->make_current_calls++;
+
+    // Read the epoch before calling into the platform, so that a concurrent
+    // destroy leaves the new binding stale.
+    epoch = wcore_tinfo_binding_epoch();
+
+    if (binding->valid &&
+        binding->epoch == epoch &&
+        binding->display == wc_dpy &&
+        binding->window == wc_window &&
+        binding->context == wc_ctx) {
+        tinfo->make_current_rebinds++;
+
+        if (api_platform->make_current_elision) {
+            tinfo->make_current_elided++;
+            return true;
+        }
+    }
+
+    ok = api_platform->vtbl->make_current(api_platform,
+                                          wc_dpy,
+                                          wc_window,
+                                          wc_ctx);
+
+    // After a failure, the thread's binding is unknown.
+    binding->display = wc_dpy;
+    binding->window = wc_window;
+    binding->context = wc_ctx;
+    binding->epoch = epoch;
+    binding->valid = ok;
+    return ok;
+}
+
+WAFFLE_API bool
+waffle_get_make_current_stats(struct waffle_make_current_stats *stats)
+{
+    struct wcore_tinfo *tinfo;
+
+    if (!api_check_entry(NULL, 0))
+        return false;
+
+    if (!stats) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "stats is null");
+        return false;
+    }
+
+    tinfo = wcore_tinfo_get();
+    stats->calls = tinfo->make_current_calls;
+    stats->rebinds = tinfo->make_current_rebinds;
+    stats->elided = tinfo->make_current_elided;
+    return true;
 }
 
 WAFFLE_API void*
 waffle_get_proc_address(const char *name)
 {
+    const int32_t ns = WCORE_PROC_CACHE_GET_PROC_ADDRESS;
+    void *proc;
+
     if (!api_check_entry(NULL, 0))
         return NULL;
 
-    return api_platform->vtbl->get_proc_address(api_platform, name);
+    if (api_platform->proc_address_per_context)
+        return api_platform->vtbl->get_proc_address(api_platform, name);
+
+    if (wcore_proc_cache_lookup(api_platform->proc_cache, ns, name, &proc))
+        return proc;
+
+    proc = api_platform->vtbl->get_proc_address(api_platform, name);
+    wcore_proc_cache_insert(api_platform->proc_cache, ns, name, proc);
+    return proc;
+}
+
+WAFFLE_API int32_t
+waffle_get_proc_address_many(int32_t count,
+                             const char *const *names,
+                             void **procs)
+{
+    const int32_t ns = WCORE_PROC_CACHE_GET_PROC_ADDRESS;
+    struct wcore_proc_cache *cache;
+    int32_t found = 0;
+
+    if (!api_check_entry(NULL, 0))
+        return -1;
+
+    if (count < 0 || (count > 0 && (!names || !procs))) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "bad symbol array (count=%d)", count);
+        return -1;
+    }
+
+    if (api_platform->proc_address_per_context) {
+        for (int32_t i = 0; i < count; ++i) {
+            procs[i] = NULL;
+            if (names[i])
+                procs[i] = api_platform->vtbl->get_proc_address(api_platform,
+                                                                names[i]);
+            if (procs[i])
+                found++;
+        }
+        return found;
+    }
+
+    cache = api_platform->proc_cache;
+    found = wcore_proc_cache_lookup_many(cache, ns, count, names, procs);
+    if (found == count)
+        return found;
+
+    for (int32_t i = 0; i < count; ++i) {
+        if (!procs[i] && names[i]) {
+            procs[i] = api_platform->vtbl->get_proc_address(api_platform,
+                                                            names[i]);
+            if (procs[i])
+                found++;
+        }
+    }
+
+    wcore_proc_cache_insert_many(cache, ns, count, names, procs);
+    return found;
+}
+
+WAFFLE_API bool
+waffle_get_symbol_cache_stats(struct waffle_symbol_cache_stats *stats)
+{
+    if (!api_check_entry(NULL, 0))
+        return false;
+
+    if (!stats) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "stats is null");
+        return false;
+    }
+
+    wcore_proc_cache_get_stats(api_platform->proc_cache, stats);
+    return true;
 }
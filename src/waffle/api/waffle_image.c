@@ -0,0 +1,135 @@
+// Copyright 2016 Google
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "api_priv.h"
+
+#include "wcore_context.h"
+#include "wcore_error.h"
+#include "wcore_image.h"
+#include "wcore_platform.h"
+
+WAFFLE_API struct waffle_image*
+waffle_image_create_from_texture(struct waffle_context *ctx,
+                                 uint32_t texture,
+                                 int32_t level)
+{
+    struct wcore_context *wc_ctx = wcore_context(ctx);
+    struct wcore_image *wc_self;
+
+    const struct api_object *obj_list[] = {
+        wc_ctx ? &wc_ctx->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return NULL;
+
+    if (texture == 0) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "texture is 0");
+        return NULL;
+    }
+
+    if (level < 0) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "level has bad value %d", level);
+        return NULL;
+    }
+
+    if (!api_platform->vtbl->image.create_from_texture) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return NULL;
+    }
+
+    wc_self = api_platform->vtbl->image.create_from_texture(api_platform,
+                                                            wc_ctx,
+                                                            texture,
+                                                            level);
+    if (!wc_self)
+        return NULL;
+
+    return waffle_image(wc_self);
+}
+
+WAFFLE_API struct waffle_image*
+waffle_image_create_from_renderbuffer(struct waffle_context *ctx,
+                                      uint32_t renderbuffer)
+{
+    struct wcore_context *wc_ctx = wcore_context(ctx);
+    struct wcore_image *wc_self;
+
+    const struct api_object *obj_list[] = {
+        wc_ctx ? &wc_ctx->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return NULL;
+
+    if (renderbuffer == 0) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "renderbuffer is 0");
+        return NULL;
+    }
+
+    if (!api_platform->vtbl->image.create_from_renderbuffer) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return NULL;
+    }
+
+    wc_self = api_platform->vtbl->image.create_from_renderbuffer(
+                    api_platform, wc_ctx, renderbuffer);
+    if (!wc_self)
+        return NULL;
+
+    return waffle_image(wc_self);
+}
+
+WAFFLE_API bool
+waffle_image_destroy(struct waffle_image *self)
+{
+    struct wcore_image *wc_self = wcore_image(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    return api_platform->vtbl->image.destroy(wc_self);
+}
+
+WAFFLE_API bool
+waffle_image_bind_texture(struct waffle_image *self,
+                          uint32_t target)
+{
+    struct wcore_image *wc_self = wcore_image(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    return api_platform->vtbl->image.bind_texture(wc_self, target);
+}
@@ -27,6 +27,7 @@
 
 #include "wcore_error.h"
 #include "wcore_platform.h"
+#include "wcore_tinfo.h"
 
 struct wcore_platform* cgl_platform_create(void);
 struct wcore_platform* droid_platform_create(void);
@@ -36,14 +37,19 @@ struct wcore_platform* xegl_platform_create(void);
 struct wcore_platform* wgbm_platform_create(void);
 struct wcore_platform* wgl_platform_create(void);
 struct wcore_platform* nacl_platform_create(void);
+struct wcore_platform* sl_platform_create(void);
+struct wcore_platform* edev_platform_create(void);
 
 static bool
 waffle_init_parse_attrib_list(
         const int32_t attrib_list[],
-        int *platform)
+        int *platform,
+        bool *make_current_elision)
 {
     bool found_platform = false;
 
+    *make_current_elision = true;
+
     for (const int32_t *i = attrib_list; *i != 0; i += 2) {
         const int32_t attr = i[0];
         const int32_t value = i[1];
@@ -111,6 +117,18 @@ waffle_init_parse_attrib_list(
                     CASE_UNDEFINED_PLATFORM(NACL)
 #endif
 
+#ifdef WAFFLE_HAS_SURFACELESS_EGL
+                    CASE_DEFINED_PLATFORM(SURFACELESS_EGL)
+#else
+                    CASE_UNDEFINED_PLATFORM(SURFACELESS_EGL)
+#endif
+
+#ifdef WAFFLE_HAS_EGL_DEVICE
+                    CASE_DEFINED_PLATFORM(EGL_DEVICE)
+#else
+                    CASE_UNDEFINED_PLATFORM(EGL_DEVICE)
+#endif
+
                     default:
                         wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
                                      "WAFFLE_PLATFORM has bad value 0x%x",
@@ -121,6 +139,20 @@ waffle_init_parse_attrib_list(
                     #undef CASE_UNDEFINED_PLATFORM
                 }
 
+                break;
+            case WAFFLE_MAKE_CURRENT_ELISION:
+                switch (value) {
+                    case true:
+                    case false:
+                        *make_current_elision = value;
+                        break;
+                    default:
+                        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                                     "WAFFLE_MAKE_CURRENT_ELISION has bad "
+                                     "value 0x%x; must be true(1) or "
+                                     "false(0)", value);
+                        return false;
+                }
                 break;
             default:
                 wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
@@ -174,6 +206,14 @@ waffle_init_create_platform(int32_t waffle_platform)
 #ifdef WAFFLE_HAS_NACL
         case WAFFLE_PLATFORM_NACL:
             return nacl_platform_create();
+#endif
+#ifdef WAFFLE_HAS_SURFACELESS_EGL
+        case WAFFLE_PLATFORM_SURFACELESS_EGL:
+            return sl_platform_create();
+#endif
+#ifdef WAFFLE_HAS_EGL_DEVICE
+        case WAFFLE_PLATFORM_EGL_DEVICE:
+            return edev_platform_create();
 #endif
         default:
             assert(false);
@@ -186,6 +226,7 @@ waffle_init(const int32_t *attrib_list)
 {
     bool ok = true;
     int platform;
+    bool make_current_elision;
 
     wcore_error_reset();
 
@@ -194,7 +235,8 @@ waffle_init(const int32_t *attrib_list)
         return false;
     }
 
-    ok &= waffle_init_parse_attrib_list(attrib_list, &platform);
+    ok &= waffle_init_parse_attrib_list(attrib_list, &platform,
+                                        &make_current_elision);
     if (!ok)
         return false;
 
@@ -202,6 +244,7 @@ waffle_init(const int32_t *attrib_list)
     if (!api_platform)
         return false;
 
+    api_platform->make_current_elision = make_current_elision;
     return true;
 }
 
@@ -217,6 +260,8 @@ waffle_teardown(void)
         return false;
     }
 
+    wcore_tinfo_invalidate_bindings();
+
     ok &= api_platform->vtbl->destroy(api_platform);
     if (!ok)
         return false;
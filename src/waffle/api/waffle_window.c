@@ -31,6 +31,7 @@
 #include "wcore_config.h"
 #include "wcore_error.h"
 #include "wcore_platform.h"
+#include "wcore_tinfo.h"
 #include "wcore_window.h"
 
 WAFFLE_API struct waffle_window*
@@ -44,6 +45,7 @@ waffle_window_create2(
     intptr_t width = 1, height = 1;
     bool need_size = true;
     intptr_t fullscreen = WAFFLE_DONT_CARE;
+    intptr_t offscreen = WAFFLE_DONT_CARE;
 
     const struct api_object *obj_list[] = {
         wc_config ? &wc_config->api : NULL,
@@ -71,6 +73,26 @@ waffle_window_create2(
         goto done;
     }
 
+    wcore_attrib_list_pop(attrib_list_filtered,
+                          WAFFLE_WINDOW_OFFSCREEN, &offscreen);
+    if (offscreen == WAFFLE_DONT_CARE)
+        offscreen = 0; // default
+
+    if (offscreen != 0 && offscreen != 1) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "WAFFLE_WINDOW_OFFSCREEN has bad value 0x%x. "
+                     "Must be true(1), false(0), or WAFFLE_DONT_CARE(-1)",
+                     offscreen);
+        goto done;
+    }
+
+    if (offscreen && fullscreen) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "WAFFLE_WINDOW_OFFSCREEN and WAFFLE_WINDOW_FULLSCREEN "
+                     "are mutually exclusive");
+        goto done;
+    }
+
     if (!wcore_attrib_list_pop(attrib_list_filtered,
                                WAFFLE_WINDOW_WIDTH, &width) && need_size) {
         wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
@@ -108,11 +130,26 @@ waffle_window_create2(
     if (fullscreen)
         width = height = -1;
 
-    wc_self = api_platform->vtbl->window.create(api_platform,
-                                                wc_config,
-                                                (int32_t) width,
-                                                (int32_t) height,
-                                                attrib_list_filtered);
+    if (offscreen) {
+        if (!api_platform->vtbl->window.create_offscreen) {
+            wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                         "offscreen windows are not supported");
+            goto done;
+        }
+
+        wc_self = api_platform->vtbl->window.create_offscreen(
+                                            api_platform,
+                                            wc_config,
+                                            (int32_t) width,
+                                            (int32_t) height,
+                                            attrib_list_filtered);
+    } else {
+        wc_self = api_platform->vtbl->window.create(api_platform,
+                                                    wc_config,
+                                                    (int32_t) width,
+                                                    (int32_t) height,
+                                                    attrib_list_filtered);
+    }
 
 done:
     free(attrib_list_filtered);
@@ -150,6 +187,7 @@ waffle_window_destroy(struct waffle_window *self)
     if (!api_check_entry(obj_list, 1))
         return false;
 
+    wcore_tinfo_invalidate_bindings();
     return api_platform->vtbl->window.destroy(wc_self);
 }
 
@@ -207,6 +245,206 @@ waffle_window_swap_buffers(struct waffle_window *self)
     return api_platform->vtbl->window.swap_buffers(wc_self);
 }
 
+WAFFLE_API bool
+waffle_window_swap_buffers_with_damage(
+        struct waffle_window *self,
+        const int32_t *rects,
+        int32_t n_rects)
+{
+    struct wcore_window *wc_self = wcore_window(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    if (n_rects < 0) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "n_rects has bad value %d", n_rects);
+        return false;
+    }
+
+    if (n_rects > 0 && !rects) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "rects is null");
+        return false;
+    }
+
+    if (!api_platform->vtbl->window.swap_buffers_with_damage)
+        return api_platform->vtbl->window.swap_buffers(wc_self);
+
+    return api_platform->vtbl->window.swap_buffers_with_damage(wc_self,
+                                                               rects,
+                                                               n_rects);
+}
+
+WAFFLE_API bool
+waffle_window_get_frame_timing(
+        struct waffle_window *self,
+        struct waffle_frame_timing *timing)
+{
+    struct wcore_window *wc_self = wcore_window(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    if (!timing) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "timing is null");
+        return false;
+    }
+
+    if (!api_platform->vtbl->window.get_frame_timing) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return false;
+    }
+
+    return api_platform->vtbl->window.get_frame_timing(wc_self, timing);
+}
+
+WAFFLE_API bool
+waffle_window_query_buffer_age(
+        struct waffle_window *self,
+        int32_t *age)
+{
+    struct wcore_window *wc_self = wcore_window(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    if (!age) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "age is null");
+        return false;
+    }
+
+    if (!api_platform->vtbl->window.query_buffer_age) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return false;
+    }
+
+    return api_platform->vtbl->window.query_buffer_age(wc_self, age);
+}
+
+WAFFLE_API bool
+waffle_window_set_damage_region(
+        struct waffle_window *self,
+        const int32_t *rects,
+        int32_t n_rects)
+{
+    struct wcore_window *wc_self = wcore_window(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    if (n_rects < 0) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "n_rects has bad value %d", n_rects);
+        return false;
+    }
+
+    if (n_rects > 0 && !rects) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "rects is null");
+        return false;
+    }
+
+    if (!api_platform->vtbl->window.set_damage_region) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return false;
+    }
+
+    return api_platform->vtbl->window.set_damage_region(wc_self,
+                                                        rects, n_rects);
+}
+
+WAFFLE_API bool
+waffle_window_acquire_frame(
+        struct waffle_window *self,
+        struct waffle_frame *frame)
+{
+    struct wcore_window *wc_self = wcore_window(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    if (!frame) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "frame is null");
+        return false;
+    }
+
+    if (!api_platform->vtbl->window.acquire_frame) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return false;
+    }
+
+    return api_platform->vtbl->window.acquire_frame(wc_self, frame);
+}
+
+WAFFLE_API bool
+waffle_window_release_frame(
+        struct waffle_window *self,
+        struct waffle_frame *frame)
+{
+    struct wcore_window *wc_self = wcore_window(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    if (!frame || !frame->priv) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "frame was not acquired");
+        return false;
+    }
+
+    if (!api_platform->vtbl->window.release_frame) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return false;
+    }
+
+    return api_platform->vtbl->window.release_frame(wc_self, frame);
+}
+
+WAFFLE_API bool
+waffle_window_set_swap_interval(
+        struct waffle_window *self,
+        int32_t interval)
+{
+    struct wcore_window *wc_self = wcore_window(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    if (!api_platform->vtbl->window.set_swap_interval) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return false;
+    }
+
+    return api_platform->vtbl->window.set_swap_interval(wc_self, interval);
+}
+
 WAFFLE_API union waffle_native_window*
 waffle_window_get_native(struct waffle_window *self)
 {
@@ -60,3 +60,15 @@ wcore_display_init(struct wcore_display *self,
 
     return true;
 }
+
+bool
+wcore_display_set_extensions(struct wcore_display *self,
+                             const char *extension_string)
+{
+    assert(self);
+    assert(extension_string);
+    assert(!self->extensions);
+
+    self->extensions = wcore_extensions_parse(extension_string);
+    return self->extensions != NULL;
+}
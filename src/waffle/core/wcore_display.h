@@ -31,6 +31,7 @@
 
 #include "api_object.h"
 
+#include "wcore_extensions.h"
 #include "wcore_util.h"
 
 #ifdef __cplusplus
@@ -44,6 +45,10 @@ union waffle_native_display;
 struct wcore_display {
     struct api_object api;
     struct wcore_platform *platform;
+
+    /// The display's EGL, GLX or WGL extensions, if the platform set them
+    /// with wcore_display_set_extensions().
+    struct wcore_extensions *extensions;
 };
 
 static inline struct waffle_display*
@@ -61,11 +66,28 @@ wcore_display_init(struct wcore_display *self,
                    struct wcore_platform *platform);
 
 
+/// @brief Parse @a extension_string into `self->extensions`.
+bool
+wcore_display_set_extensions(struct wcore_display *self,
+                             const char *extension_string);
+
+/// @brief Test if the display has extension @a name.
+///
+/// Must be called only after wcore_display_set_extensions().
+static inline bool
+wcore_display_has_extension(const struct wcore_display *self,
+                            const char *name)
+{
+    return wcore_extensions_has(self->extensions, name);
+}
+
 static inline bool
 wcore_display_teardown(struct wcore_display *self)
 {
-    (void) self;
     assert(self);
+
+    wcore_extensions_destroy(self->extensions);
+    self->extensions = NULL;
     return true;
 }
 
@@ -0,0 +1,229 @@
+// Copyright 2016 Google
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "wcore_extension_string.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#   if defined(__SSE2__)
+#       include <emmintrin.h>
+#       define WCORE_HAVE_SSE2 1
+#   endif
+#   if defined(__clang__) || __GNUC__ >= 5
+#       include <immintrin.h>
+#       define WCORE_HAVE_AVX2 1
+#   endif
+#endif
+
+/// Test if the token starting at @a t is @a name.
+static inline bool
+token_matches(const char *t, const char *name, size_t name_length)
+{
+    return strncmp(t, name, name_length) == 0 &&
+           (t[name_length] == ' ' || t[name_length] == '\0');
+}
+
+static bool
+match_scalar(const char *s, const char *name, size_t name_length)
+{
+    // strstr() is well optimized by the C library. Skip the occurrences that
+    // do not start a token, like "GL_ARB_sync" within "XGL_ARB_sync".
+    for (const char *t = s; (t = strstr(t, name)); ++t) {
+        if ((t == s || t[-1] == ' ') &&
+            (t[name_length] == ' ' || t[name_length] == '\0'))
+            return true;
+    }
+
+    return false;
+}
+
+#if defined(WCORE_HAVE_SSE2) || defined(WCORE_HAVE_AVX2)
+/// Compare the candidates in @a mask, relative to @a t. Kept out of line so
+/// that the vector loops keep their state in registers.
+static bool __attribute__((noinline))
+match_candidates(const char *t, uint32_t mask,
+                 const char *name, size_t name_length)
+{
+    for (; mask; mask &= mask - 1) {
+        if (memcmp(t + __builtin_ctz(mask), name, name_length) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+/// Finish a vector matcher: check each token start in [i, n) of @a s, whose
+/// length is @a n.
+static bool
+match_tail(const char *s, size_t n, size_t i,
+           const char *name, size_t name_length)
+{
+    for (; i + name_length <= n; ++i) {
+        if ((i == 0 || s[i - 1] == ' ') && s[i] == name[0] &&
+            token_matches(s + i, name, name_length))
+            return true;
+    }
+
+    return false;
+}
+#endif
+
+// The vector matchers test 16 or 32 candidate positions at once. Position i
+// remains a candidate if s[i] starts a token and equals the first character
+// of the name, s[i + name_length - 1] equals its last character, and
+// s[i + name_length] is a space. The few candidates left are compared in
+// full. All loads stay within the string, whose length is found first, and
+// the last bytes are left to match_tail().
+
+#ifdef WCORE_HAVE_SSE2
+static bool
+match_sse2(const char *s, const char *name, size_t name_length)
+{
+    const size_t n = strlen(s);
+    const __m128i first = _mm_set1_epi8(name[0]);
+    const __m128i last = _mm_set1_epi8(name[name_length - 1]);
+    const __m128i space = _mm_set1_epi8(' ');
+
+    // Bit 0 is set if the block starts a token.
+    uint32_t carry = 1;
+    size_t i = 0;
+
+    for (; i + name_length + 16 <= n; i += 16) {
+        __m128i a = _mm_loadu_si128((const __m128i *) (s + i));
+        __m128i b = _mm_loadu_si128((const __m128i *) (s + i + name_length - 1));
+        __m128i c = _mm_loadu_si128((const __m128i *) (s + i + name_length));
+        uint32_t a_space = _mm_movemask_epi8(_mm_cmpeq_epi8(a, space));
+        uint32_t mask = ((a_space << 1) | carry) &
+                        _mm_movemask_epi8(_mm_cmpeq_epi8(a, first)) &
+                        _mm_movemask_epi8(_mm_cmpeq_epi8(b, last)) &
+                        _mm_movemask_epi8(_mm_cmpeq_epi8(c, space));
+
+        carry = a_space >> 15;
+
+        if (mask && match_candidates(s + i, mask, name, name_length))
+            return true;
+    }
+
+    return match_tail(s, n, i, name, name_length);
+}
+#endif
+
+#ifdef WCORE_HAVE_AVX2
+// Same as match_sse2(), on 32-byte blocks.
+static bool __attribute__((target("avx2")))
+match_avx2(const char *s, const char *name, size_t name_length)
+{
+    const size_t n = strlen(s);
+    const __m256i first = _mm256_set1_epi8(name[0]);
+    const __m256i last = _mm256_set1_epi8(name[name_length - 1]);
+    const __m256i space = _mm256_set1_epi8(' ');
+
+    uint32_t carry = 1;
+    size_t i = 0;
+
+    for (; i + name_length + 32 <= n; i += 32) {
+        __m256i a = _mm256_loadu_si256((const __m256i *) (s + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *) (s + i + name_length - 1));
+        __m256i c = _mm256_loadu_si256((const __m256i *) (s + i + name_length));
+        uint32_t a_space = _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, space));
+        uint32_t mask = ((a_space << 1) | carry) &
+                        _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, first)) &
+                        _mm256_movemask_epi8(_mm256_cmpeq_epi8(b, last)) &
+                        _mm256_movemask_epi8(_mm256_cmpeq_epi8(c, space));
+
+        carry = a_space >> 31;
+
+        if (mask && match_candidates(s + i, mask, name, name_length))
+            return true;
+    }
+
+    return match_tail(s, n, i, name, name_length);
+}
+#endif
+
+bool
+wcore_extension_matcher_is_available(enum wcore_extension_matcher matcher)
+{
+    switch (matcher) {
+        case WCORE_EXTENSION_MATCHER_SCALAR:
+            return true;
+        case WCORE_EXTENSION_MATCHER_SSE2:
+#ifdef WCORE_HAVE_SSE2
+            return true;
+#else
+            return false;
+#endif
+        case WCORE_EXTENSION_MATCHER_AVX2:
+#ifdef WCORE_HAVE_AVX2
+            return __builtin_cpu_supports("avx2");
+#else
+            return false;
+#endif
+    }
+
+    return false;
+}
+
+bool
+wcore_extension_in_string_with(enum wcore_extension_matcher matcher,
+                               const char *extensions,
+                               const char *name,
+                               size_t name_length)
+{
+    assert(name_length > 0);
+    assert(wcore_extension_matcher_is_available(matcher));
+
+    switch (matcher) {
+#ifdef WCORE_HAVE_AVX2
+        case WCORE_EXTENSION_MATCHER_AVX2:
+            return match_avx2(extensions, name, name_length);
+#endif
+#ifdef WCORE_HAVE_SSE2
+        case WCORE_EXTENSION_MATCHER_SSE2:
+            return match_sse2(extensions, name, name_length);
+#endif
+        default:
+            return match_scalar(extensions, name, name_length);
+    }
+}
+
+bool
+wcore_extension_in_string(const char *extensions,
+                          const char *name,
+                          size_t name_length)
+{
+    assert(name_length > 0);
+
+    // The SSE2 matcher is not dispatched to: it loses to the C library's
+    // strstr(), which is itself vectorized. It remains for the benchmark.
+#ifdef WCORE_HAVE_AVX2
+    if (__builtin_cpu_supports("avx2"))
+        return match_avx2(extensions, name, name_length);
+#endif
+    return match_scalar(extensions, name, name_length);
+}
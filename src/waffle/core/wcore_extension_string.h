@@ -0,0 +1,61 @@
+// Copyright 2016 Google
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/// @file
+/// @brief Search a space-separated extension string for one name.
+///
+/// Only token starts are candidate matches, so a name is never matched as a
+/// prefix or suffix of a longer extension. On x86 CPUs with AVX2, the string
+/// is scanned 32 bytes at a time; elsewhere strstr() does the scanning.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+enum wcore_extension_matcher {
+    WCORE_EXTENSION_MATCHER_SCALAR,
+    WCORE_EXTENSION_MATCHER_SSE2,
+    WCORE_EXTENSION_MATCHER_AVX2,
+};
+
+/// @brief Test if @a name, of length @a name_length > 0, is a token of
+/// @a extensions. Uses the fastest matcher available.
+bool
+wcore_extension_in_string(const char *extensions,
+                          const char *name,
+                          size_t name_length);
+
+/// @brief Test if @a matcher is built in and supported by the CPU.
+bool
+wcore_extension_matcher_is_available(enum wcore_extension_matcher matcher);
+
+/// @brief Same as wcore_extension_in_string() with a given matcher, for
+/// tests and benchmarks. The matcher must be available.
+bool
+wcore_extension_in_string_with(enum wcore_extension_matcher matcher,
+                               const char *extensions,
+                               const char *name,
+                               size_t name_length);
@@ -0,0 +1,373 @@
+// Copyright 2016 Google
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/// @file
+/// @brief Benchmark the matchers of waffle_is_extension_in_string().
+///
+/// Usage: wcore_extension_string_bench [FILE...]
+///
+/// Each FILE holds one extension string, such as the "OpenGL extensions"
+/// line printed by `wflinfo --verbose` on the driver of interest. Without
+/// arguments, a GL_EXTENSIONS string of Mesa's llvmpipe is used. For each
+/// string, every listed extension is looked up, as well as a name that
+/// extends each one and so is not listed.
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "wcore_extension_string.h"
+#include "wcore_extensions.h"
+
+// Mesa 22.3.6, llvmpipe (LLVM 15.0.6), compatibility profile.
+static const char mesa_llvmpipe[] =
+    "GL_3DFX_texture_compression_FXT1 GL_AMD_conservative_depth "
+    "GL_AMD_draw_buffers_blend GL_AMD_multi_draw_indirect "
+    "GL_AMD_pinned_memory GL_AMD_query_buffer_object "
+    "GL_AMD_seamless_cubemap_per_texture GL_AMD_shader_stencil_export "
+    "GL_AMD_shader_trinary_minmax GL_AMD_texture_texture4 "
+    "GL_AMD_vertex_shader_layer GL_AMD_vertex_shader_viewport_index "
+    "GL_ANGLE_texture_compression_dxt3 GL_ANGLE_texture_compression_dxt5 "
+    "GL_APPLE_packed_pixels GL_ARB_ES2_compatibility "
+    "GL_ARB_ES3_1_compatibility GL_ARB_ES3_2_compatibility "
+    "GL_ARB_ES3_compatibility GL_ARB_arrays_of_arrays "
+    "GL_ARB_base_instance GL_ARB_blend_func_extended "
+    "GL_ARB_buffer_storage GL_ARB_clear_buffer_object "
+    "GL_ARB_clear_texture GL_ARB_clip_control GL_ARB_color_buffer_float "
+    "GL_ARB_compatibility GL_ARB_compressed_texture_pixel_storage "
+    "GL_ARB_compute_shader GL_ARB_conditional_render_inverted "
+    "GL_ARB_conservative_depth GL_ARB_copy_buffer GL_ARB_copy_image "
+    "GL_ARB_cull_distance GL_ARB_debug_output GL_ARB_depth_buffer_float "
+    "GL_ARB_depth_clamp GL_ARB_depth_texture GL_ARB_derivative_control "
+    "GL_ARB_direct_state_access GL_ARB_draw_buffers "
+    "GL_ARB_draw_buffers_blend GL_ARB_draw_elements_base_vertex "
+    "GL_ARB_draw_indirect GL_ARB_draw_instanced GL_ARB_enhanced_layouts "
+    "GL_ARB_explicit_attrib_location GL_ARB_explicit_uniform_location "
+    "GL_ARB_fragment_coord_conventions GL_ARB_fragment_layer_viewport "
+    "GL_ARB_fragment_program GL_ARB_fragment_program_shadow "
+    "GL_ARB_fragment_shader GL_ARB_framebuffer_no_attachments "
+    "GL_ARB_framebuffer_object GL_ARB_framebuffer_sRGB "
+    "GL_ARB_get_program_binary GL_ARB_get_texture_sub_image "
+    "GL_ARB_gl_spirv GL_ARB_gpu_shader5 GL_ARB_gpu_shader_fp64 "
+    "GL_ARB_gpu_shader_int64 GL_ARB_half_float_pixel "
+    "GL_ARB_half_float_vertex GL_ARB_indirect_parameters "
+    "GL_ARB_instanced_arrays GL_ARB_internalformat_query "
+    "GL_ARB_internalformat_query2 GL_ARB_invalidate_subdata "
+    "GL_ARB_map_buffer_alignment GL_ARB_map_buffer_range "
+    "GL_ARB_multi_bind GL_ARB_multi_draw_indirect GL_ARB_multisample "
+    "GL_ARB_multitexture GL_ARB_occlusion_query GL_ARB_occlusion_query2 "
+    "GL_ARB_parallel_shader_compile GL_ARB_pipeline_statistics_query "
+    "GL_ARB_pixel_buffer_object GL_ARB_point_parameters "
+    "GL_ARB_point_sprite GL_ARB_polygon_offset_clamp "
+    "GL_ARB_post_depth_coverage GL_ARB_program_interface_query "
+    "GL_ARB_provoking_vertex GL_ARB_query_buffer_object "
+    "GL_ARB_robust_buffer_access_behavior GL_ARB_robustness "
+    "GL_ARB_sample_shading GL_ARB_sampler_objects "
+    "GL_ARB_seamless_cube_map GL_ARB_seamless_cubemap_per_texture "
+    "GL_ARB_separate_shader_objects GL_ARB_shader_atomic_counter_ops "
+    "GL_ARB_shader_atomic_counters GL_ARB_shader_ballot "
+    "GL_ARB_shader_bit_encoding GL_ARB_shader_clock "
+    "GL_ARB_shader_draw_parameters GL_ARB_shader_group_vote "
+    "GL_ARB_shader_image_load_store GL_ARB_shader_image_size "
+    "GL_ARB_shader_objects GL_ARB_shader_precision "
+    "GL_ARB_shader_stencil_export GL_ARB_shader_storage_buffer_object "
+    "GL_ARB_shader_subroutine GL_ARB_shader_texture_image_samples "
+    "GL_ARB_shader_texture_lod GL_ARB_shader_viewport_layer_array "
+    "GL_ARB_shading_language_100 GL_ARB_shading_language_420pack "
+    "GL_ARB_shading_language_include GL_ARB_shading_language_packing "
+    "GL_ARB_shadow GL_ARB_spirv_extensions GL_ARB_stencil_texturing "
+    "GL_ARB_sync GL_ARB_tessellation_shader GL_ARB_texture_barrier "
+    "GL_ARB_texture_border_clamp GL_ARB_texture_buffer_object "
+    "GL_ARB_texture_buffer_object_rgb32 GL_ARB_texture_buffer_range "
+    "GL_ARB_texture_compression GL_ARB_texture_compression_bptc "
+    "GL_ARB_texture_compression_rgtc GL_ARB_texture_cube_map "
+    "GL_ARB_texture_cube_map_array GL_ARB_texture_env_add "
+    "GL_ARB_texture_env_combine GL_ARB_texture_env_crossbar "
+    "GL_ARB_texture_env_dot3 GL_ARB_texture_filter_anisotropic "
+    "GL_ARB_texture_filter_minmax GL_ARB_texture_float "
+    "GL_ARB_texture_gather GL_ARB_texture_mirror_clamp_to_edge "
+    "GL_ARB_texture_mirrored_repeat GL_ARB_texture_multisample "
+    "GL_ARB_texture_non_power_of_two GL_ARB_texture_query_levels "
+    "GL_ARB_texture_query_lod GL_ARB_texture_rectangle GL_ARB_texture_rg "
+    "GL_ARB_texture_rgb10_a2ui GL_ARB_texture_stencil8 "
+    "GL_ARB_texture_storage GL_ARB_texture_storage_multisample "
+    "GL_ARB_texture_swizzle GL_ARB_texture_view GL_ARB_timer_query "
+    "GL_ARB_transform_feedback2 GL_ARB_transform_feedback3 "
+    "GL_ARB_transform_feedback_instanced "
+    "GL_ARB_transform_feedback_overflow_query GL_ARB_transpose_matrix "
+    "GL_ARB_uniform_buffer_object GL_ARB_vertex_array_bgra "
+    "GL_ARB_vertex_array_object GL_ARB_vertex_attrib_64bit "
+    "GL_ARB_vertex_attrib_binding GL_ARB_vertex_buffer_object "
+    "GL_ARB_vertex_program GL_ARB_vertex_shader "
+    "GL_ARB_vertex_type_10f_11f_11f_rev "
+    "GL_ARB_vertex_type_2_10_10_10_rev GL_ARB_viewport_array "
+    "GL_ARB_window_pos GL_ARM_shader_framebuffer_fetch_depth_stencil "
+    "GL_ATI_blend_equation_separate GL_ATI_draw_buffers "
+    "GL_ATI_fragment_shader GL_ATI_separate_stencil "
+    "GL_ATI_texture_compression_3dc GL_ATI_texture_env_combine3 "
+    "GL_ATI_texture_float GL_ATI_texture_mirror_once "
+    "GL_EXT_EGL_image_storage GL_EXT_EGL_sync GL_EXT_abgr GL_EXT_bgra "
+    "GL_EXT_blend_color GL_EXT_blend_equation_separate "
+    "GL_EXT_blend_func_separate GL_EXT_blend_minmax "
+    "GL_EXT_blend_subtract GL_EXT_compiled_vertex_array "
+    "GL_EXT_copy_texture GL_EXT_debug_label GL_EXT_direct_state_access "
+    "GL_EXT_draw_buffers2 GL_EXT_draw_instanced "
+    "GL_EXT_draw_range_elements GL_EXT_fog_coord GL_EXT_framebuffer_blit "
+    "GL_EXT_framebuffer_multisample "
+    "GL_EXT_framebuffer_multisample_blit_scaled "
+    "GL_EXT_framebuffer_object GL_EXT_framebuffer_sRGB "
+    "GL_EXT_gpu_program_parameters GL_EXT_gpu_shader4 "
+    "GL_EXT_memory_object GL_EXT_memory_object_fd "
+    "GL_EXT_multi_draw_arrays GL_EXT_packed_depth_stencil "
+    "GL_EXT_packed_float GL_EXT_packed_pixels GL_EXT_pixel_buffer_object "
+    "GL_EXT_point_parameters GL_EXT_polygon_offset_clamp "
+    "GL_EXT_provoking_vertex GL_EXT_rescale_normal "
+    "GL_EXT_secondary_color GL_EXT_separate_specular_color "
+    "GL_EXT_shader_framebuffer_fetch "
+    "GL_EXT_shader_framebuffer_fetch_non_coherent "
+    "GL_EXT_shader_integer_mix GL_EXT_shadow_funcs "
+    "GL_EXT_stencil_two_side GL_EXT_stencil_wrap GL_EXT_subtexture "
+    "GL_EXT_texture GL_EXT_texture3D GL_EXT_texture_array "
+    "GL_EXT_texture_buffer_object GL_EXT_texture_compression_dxt1 "
+    "GL_EXT_texture_compression_latc GL_EXT_texture_compression_rgtc "
+    "GL_EXT_texture_compression_s3tc GL_EXT_texture_cube_map "
+    "GL_EXT_texture_edge_clamp GL_EXT_texture_env_add "
+    "GL_EXT_texture_env_combine GL_EXT_texture_env_dot3 "
+    "GL_EXT_texture_filter_anisotropic GL_EXT_texture_filter_minmax "
+    "GL_EXT_texture_integer GL_EXT_texture_lod_bias "
+    "GL_EXT_texture_mirror_clamp GL_EXT_texture_object "
+    "GL_EXT_texture_rectangle GL_EXT_texture_sRGB GL_EXT_texture_sRGB_R8 "
+    "GL_EXT_texture_sRGB_RG8 GL_EXT_texture_sRGB_decode "
+    "GL_EXT_texture_shadow_lod GL_EXT_texture_shared_exponent "
+    "GL_EXT_texture_snorm GL_EXT_texture_swizzle GL_EXT_timer_query "
+    "GL_EXT_transform_feedback GL_EXT_vertex_array "
+    "GL_EXT_vertex_array_bgra GL_EXT_vertex_attrib_64bit "
+    "GL_IBM_multimode_draw_arrays GL_IBM_rasterpos_clip "
+    "GL_IBM_texture_mirrored_repeat GL_INGR_blend_func_separate "
+    "GL_INTEL_shader_atomic_float_minmax GL_KHR_blend_equation_advanced "
+    "GL_KHR_blend_equation_advanced_coherent "
+    "GL_KHR_context_flush_control GL_KHR_debug GL_KHR_no_error "
+    "GL_KHR_parallel_shader_compile GL_KHR_robust_buffer_access_behavior "
+    "GL_KHR_robustness GL_KHR_texture_compression_astc_ldr "
+    "GL_KHR_texture_compression_astc_sliced_3d "
+    "GL_MESA_framebuffer_flip_y GL_MESA_pack_invert "
+    "GL_MESA_shader_integer_functions GL_MESA_texture_signed_rgba "
+    "GL_MESA_window_pos GL_MESA_ycbcr_texture GL_NV_ES1_1_compatibility "
+    "GL_NV_blend_square GL_NV_conditional_render "
+    "GL_NV_copy_depth_to_color GL_NV_copy_image GL_NV_depth_clamp "
+    "GL_NV_fog_distance GL_NV_half_float GL_NV_light_max_exponent "
+    "GL_NV_packed_depth_stencil GL_NV_primitive_restart "
+    "GL_NV_shader_atomic_float GL_NV_texgen_reflection "
+    "GL_NV_texture_barrier GL_NV_texture_env_combine4 "
+    "GL_NV_texture_rectangle GL_OES_EGL_image GL_OES_read_format "
+    "GL_S3_s3tc GL_SGIS_generate_mipmap GL_SGIS_texture_border_clamp "
+    "GL_SGIS_texture_edge_clamp GL_SGIS_texture_lod "
+    "GL_SUN_multi_draw_arrays";
+
+/// The implementation of waffle_is_extension_in_string() before the
+/// vector matchers.
+static bool
+match_strstr(const char *extension_string, const char *extension_name,
+             size_t name_length)
+{
+    const char *search_start = extension_string;
+
+    while (true) {
+        const char *s = strstr(search_start, extension_name);
+        if (s == NULL)
+            return false;
+
+        if (s[name_length] == ' ' || s[name_length] == '\0')
+            return true;
+
+        search_start = s + name_length;
+    }
+}
+
+struct query {
+    char *name;
+    size_t length;
+};
+
+static double
+now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static char*
+read_file(const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    char *s = NULL;
+    long size;
+
+    if (!f)
+        return NULL;
+
+    if (fseek(f, 0, SEEK_END) == 0 && (size = ftell(f)) >= 0 &&
+        fseek(f, 0, SEEK_SET) == 0 && (s = malloc(size + 1))) {
+        size = fread(s, 1, size, f);
+        while (size > 0 && (s[size - 1] == '\n' || s[size - 1] == '\r'))
+            --size;
+        s[size] = '\0';
+    }
+
+    fclose(f);
+    return s;
+}
+
+/// Build the queries for @a s: each token, then each token with a suffix.
+static struct query*
+make_queries(const char *s, int *n_queries)
+{
+    struct query *queries = NULL;
+    int n = 0, cap = 0;
+
+    for (int pass = 0; pass < 2; ++pass) {
+        for (const char *t = s; *t; ) {
+            size_t len = strcspn(t, " ");
+
+            if (len > 0) {
+                if (n == cap) {
+                    cap = cap ? 2 * cap : 256;
+                    queries = realloc(queries, cap * sizeof(*queries));
+                }
+
+                queries[n].name = malloc(len + 3);
+                memcpy(queries[n].name, t, len);
+                strcpy(queries[n].name + len, pass ? "_X" : "");
+                queries[n].length = len + (pass ? 2 : 0);
+                ++n;
+            }
+
+            t += len;
+            t += strspn(t, " ");
+        }
+    }
+
+    *n_queries = n;
+    return queries;
+}
+
+static void
+bench_string(const char *label, const char *s)
+{
+    static const struct {
+        const char *name;
+        enum wcore_extension_matcher matcher;
+    } matchers[] = {
+        { "scalar", WCORE_EXTENSION_MATCHER_SCALAR },
+        { "sse2", WCORE_EXTENSION_MATCHER_SSE2 },
+        { "avx2", WCORE_EXTENSION_MATCHER_AVX2 },
+    };
+
+    int n_queries;
+    struct query *queries = make_queries(s, &n_queries);
+    int rounds = 1 + 2000000 / (n_queries * (strlen(s) / 64 + 1));
+    int expected = 0;
+    int found;
+    double t0, t1;
+
+    printf("%s: %zu bytes, %d lookups x %d rounds\n",
+           label, strlen(s), n_queries, rounds);
+
+    t0 = now_ns();
+    for (int r = 0; r < rounds; ++r) {
+        expected = 0;
+        for (int i = 0; i < n_queries; ++i)
+            expected += match_strstr(s, queries[i].name, queries[i].length);
+    }
+    t1 = now_ns();
+    printf("    %-10s %10.1f ns/lookup\n", "strstr",
+           (t1 - t0) / rounds / n_queries);
+
+    for (size_t m = 0; m < sizeof(matchers) / sizeof(matchers[0]); ++m) {
+        if (!wcore_extension_matcher_is_available(matchers[m].matcher))
+            continue;
+
+        t0 = now_ns();
+        for (int r = 0; r < rounds; ++r) {
+            found = 0;
+            for (int i = 0; i < n_queries; ++i)
+                found += wcore_extension_in_string_with(matchers[m].matcher, s,
+                                                        queries[i].name,
+                                                        queries[i].length);
+        }
+        t1 = now_ns();
+        printf("    %-10s %10.1f ns/lookup\n", matchers[m].name,
+               (t1 - t0) / rounds / n_queries);
+
+        if (found != expected) {
+            fprintf(stderr, "%s found %d extensions, strstr found %d\n",
+                    matchers[m].name, found, expected);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // For comparison, the set that waffle_display_has_extension() probes,
+    // including the cost of parsing the string once per round.
+    t0 = now_ns();
+    for (int r = 0; r < rounds; ++r) {
+        struct wcore_extensions *set = wcore_extensions_parse(s);
+        found = 0;
+        for (int i = 0; i < n_queries; ++i)
+            found += wcore_extensions_has(set, queries[i].name);
+        wcore_extensions_destroy(set);
+    }
+    t1 = now_ns();
+    printf("    %-10s %10.1f ns/lookup\n", "hash set",
+           (t1 - t0) / rounds / n_queries);
+
+    for (int i = 0; i < n_queries; ++i)
+        free(queries[i].name);
+    free(queries);
+}
+
+int
+main(int argc, char **argv)
+{
+    if (argc < 2) {
+        bench_string("mesa llvmpipe", mesa_llvmpipe);
+        return EXIT_SUCCESS;
+    }
+
+    for (int i = 1; i < argc; ++i) {
+        char *s = read_file(argv[i]);
+        if (!s) {
+            fprintf(stderr, "failed to read %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+
+        bench_string(argv[i], s);
+        free(s);
+    }
+
+    return EXIT_SUCCESS;
+}
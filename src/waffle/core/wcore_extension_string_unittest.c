@@ -0,0 +1,138 @@
+// Copyright 2016 Google
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cmocka.h>
+
+#include "wcore_extension_string.h"
+
+static const enum wcore_extension_matcher matchers[] = {
+    WCORE_EXTENSION_MATCHER_SCALAR,
+    WCORE_EXTENSION_MATCHER_SSE2,
+    WCORE_EXTENSION_MATCHER_AVX2,
+};
+
+static const char *const names[] = {
+    "GL_ARB_sync",
+    "GL_ARB_sync_extra",
+    "GL_ARB",
+    "GL_EXT_texture",
+    "GL_EXT_texture_array",
+    "GL_EXT_texture_integer",
+    "GL_KHR_debug",
+    "GL_NV_missing",
+    "G",
+};
+
+/// Extension strings that stress token boundaries: prefixes, suffixes,
+/// repeated spaces, and names at the very start and end.
+static const char *const strings[] = {
+    "",
+    " ",
+    "GL_ARB_sync",
+    "GL_ARB_sync_extra GL_EXT_texture_array",
+    "GL_EXT_texture_array GL_EXT_texture GL_KHR_debug",
+    "  GL_EXT_texture_integer   XGL_ARB_sync GL_ARB_syncX  GL_ARB_sync ",
+    "G GL_ARB",
+};
+
+static bool
+reference(const char *s, const char *name)
+{
+    size_t len = strlen(name);
+
+    for (const char *t = s; (t = strstr(t, name)); ++t) {
+        if ((t == s || t[-1] == ' ') && (t[len] == ' ' || t[len] == '\0'))
+            return true;
+    }
+
+    return false;
+}
+
+// Check every matcher against a reference, at every alignment of the string
+// within a 32-byte block. Any 64 consecutive offsets cover them all.
+static void
+test_wcore_extension_string_matchers(void **state) {
+    static char buf[256 + 64];
+
+    for (size_t m = 0; m < sizeof(matchers) / sizeof(matchers[0]); ++m) {
+        if (!wcore_extension_matcher_is_available(matchers[m]))
+            continue;
+
+        for (size_t i = 0; i < sizeof(strings) / sizeof(strings[0]); ++i) {
+            for (size_t align = 0; align < 64; ++align) {
+                char *s = buf + align;
+                strcpy(s, strings[i]);
+
+                for (size_t j = 0; j < sizeof(names) / sizeof(names[0]); ++j) {
+                    bool expect = reference(strings[i], names[j]);
+                    bool got = wcore_extension_in_string_with(
+                        matchers[m], s, names[j], strlen(names[j]));
+                    assert_int_equal(got, expect);
+                }
+            }
+        }
+    }
+}
+
+// Check matches that straddle or follow block boundaries in a long string.
+static void
+test_wcore_extension_string_long(void **state) {
+    char s[4096] = "";
+    char name[32];
+
+    for (int i = 0; i < 200; ++i) {
+        snprintf(name, sizeof(name), "GL_EXT_n%d ", i);
+        strcat(s, name);
+    }
+
+    for (size_t m = 0; m < sizeof(matchers) / sizeof(matchers[0]); ++m) {
+        if (!wcore_extension_matcher_is_available(matchers[m]))
+            continue;
+
+        for (int i = 0; i < 210; ++i) {
+            snprintf(name, sizeof(name), "GL_EXT_n%d", i);
+            assert_int_equal(wcore_extension_in_string_with(matchers[m], s,
+                                                            name, strlen(name)),
+                             i < 200);
+        }
+    }
+}
+
+int
+main(void) {
+    const UnitTest tests[] = {
+        unit_test(test_wcore_extension_string_matchers),
+        unit_test(test_wcore_extension_string_long),
+    };
+
+    return run_tests(tests);
+}
@@ -0,0 +1,150 @@
+// Copyright 2016 Google
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "wcore_extensions.h"
+#include "wcore_util.h"
+
+struct wcore_extensions {
+    /// A copy of the extension string, with each space replaced by a null
+    /// character. The slots below point into it.
+    char *names;
+
+    /// Open addressing with linear probing. The capacity is a power of 2
+    /// and at least twice the number of names. Empty slots are null.
+    const char **slots;
+    uint32_t *hashes;
+    size_t capacity;
+};
+
+// 32-bit FNV-1a.
+static uint32_t
+wcore_extensions_hash(const char *name)
+{
+    uint32_t h = 2166136261u;
+
+    for (const unsigned char *c = (const unsigned char *) name; *c; ++c) {
+        h ^= *c;
+        h *= 16777619u;
+    }
+
+    return h;
+}
+
+static size_t
+wcore_extensions_find_slot(const struct wcore_extensions *self,
+                           const char *name,
+                           uint32_t hash)
+{
+    size_t mask = self->capacity - 1;
+    size_t i;
+
+    for (i = hash & mask; self->slots[i]; i = (i + 1) & mask) {
+        if (self->hashes[i] == hash && strcmp(self->slots[i], name) == 0)
+            break;
+    }
+
+    return i;
+}
+
+struct wcore_extensions*
+wcore_extensions_parse(const char *extension_string)
+{
+    struct wcore_extensions *self;
+    size_t count = 0;
+    char *p;
+
+    self = wcore_calloc(sizeof(*self));
+    if (!self)
+        return NULL;
+
+    self->names = wcore_malloc(strlen(extension_string) + 1);
+    if (!self->names)
+        goto error;
+
+    strcpy(self->names, extension_string);
+
+    for (p = self->names; *p; ++p) {
+        if (*p == ' ')
+            *p = '\0';
+        else if (p == self->names || p[-1] == '\0')
+            count++;
+    }
+
+    self->capacity = 16;
+    while (self->capacity < 2 * count)
+        self->capacity *= 2;
+
+    self->slots = wcore_calloc(self->capacity * sizeof(*self->slots));
+    self->hashes = wcore_calloc(self->capacity * sizeof(*self->hashes));
+    if (!self->slots || !self->hashes)
+        goto error;
+
+    for (char *end = p, *name = self->names; name < end;
+         name += strlen(name) + 1) {
+        uint32_t hash;
+        size_t i;
+
+        if (!*name)
+            continue;
+
+        hash = wcore_extensions_hash(name);
+        i = wcore_extensions_find_slot(self, name, hash);
+        self->slots[i] = name;
+        self->hashes[i] = hash;
+    }
+
+    return self;
+
+error:
+    wcore_extensions_destroy(self);
+    return NULL;
+}
+
+void
+wcore_extensions_destroy(struct wcore_extensions *self)
+{
+    if (!self)
+        return;
+
+    free(self->names);
+    free(self->slots);
+    free(self->hashes);
+    free(self);
+}
+
+bool
+wcore_extensions_has(const struct wcore_extensions *self, const char *name)
+{
+    if (!self || !name || !*name)
+        return false;
+
+    return self->slots[wcore_extensions_find_slot(self, name,
+                                                  wcore_extensions_hash(name))]
+           != NULL;
+}
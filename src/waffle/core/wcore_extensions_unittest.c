@@ -0,0 +1,90 @@
+// Copyright 2016 Google
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include <cmocka.h>
+
+#include "wcore_extensions.h"
+
+static void
+test_wcore_extensions_basic(void **state) {
+    struct wcore_extensions *exts =
+        wcore_extensions_parse("EGL_KHR_fence_sync EGL_KHR_wait_sync");
+
+    assert_true(exts != NULL);
+    assert_true(wcore_extensions_has(exts, "EGL_KHR_fence_sync"));
+    assert_true(wcore_extensions_has(exts, "EGL_KHR_wait_sync"));
+    assert_false(wcore_extensions_has(exts, "EGL_KHR_image"));
+    wcore_extensions_destroy(exts);
+}
+
+static void
+test_wcore_extensions_prefix(void **state) {
+    struct wcore_extensions *exts =
+        wcore_extensions_parse("GLX_EXT_swap_control_tear GLX_ARB_create_context_profile");
+
+    assert_false(wcore_extensions_has(exts, "GLX_EXT_swap_control"));
+    assert_false(wcore_extensions_has(exts, "GLX_ARB_create_context"));
+    assert_false(wcore_extensions_has(exts, "GLX_EXT"));
+    assert_true(wcore_extensions_has(exts, "GLX_EXT_swap_control_tear"));
+    wcore_extensions_destroy(exts);
+}
+
+static void
+test_wcore_extensions_spaces(void **state) {
+    struct wcore_extensions *exts =
+        wcore_extensions_parse("  EGL_EXT_buffer_age   EGL_KHR_partial_update ");
+
+    assert_true(wcore_extensions_has(exts, "EGL_EXT_buffer_age"));
+    assert_true(wcore_extensions_has(exts, "EGL_KHR_partial_update"));
+    assert_false(wcore_extensions_has(exts, ""));
+    assert_false(wcore_extensions_has(exts, " "));
+    wcore_extensions_destroy(exts);
+}
+
+static void
+test_wcore_extensions_empty(void **state) {
+    struct wcore_extensions *exts = wcore_extensions_parse("");
+
+    assert_true(exts != NULL);
+    assert_false(wcore_extensions_has(exts, "EGL_KHR_fence_sync"));
+    wcore_extensions_destroy(exts);
+}
+
+int
+main(void) {
+    const UnitTest tests[] = {
+        unit_test(test_wcore_extensions_basic),
+        unit_test(test_wcore_extensions_prefix),
+        unit_test(test_wcore_extensions_spaces),
+        unit_test(test_wcore_extensions_empty),
+    };
+
+    return run_tests(tests);
+}
@@ -0,0 +1,159 @@
+// Copyright 2016 Google
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdlib.h>
+
+#include "wcore_error.h"
+#include "wcore_fence.h"
+#include "wcore_gl_fence.h"
+#include "wcore_platform.h"
+#include "wcore_util.h"
+
+#ifndef _WIN32
+#define APIENTRY
+#else
+#ifndef APIENTRY
+#define APIENTRY __stdcall
+#endif
+#endif
+
+#define GL_SYNC_GPU_COMMANDS_COMPLETE   0x9117
+#define GL_SYNC_FLUSH_COMMANDS_BIT      0x00000001
+#define GL_ALREADY_SIGNALED             0x911A
+#define GL_TIMEOUT_EXPIRED              0x911B
+#define GL_CONDITION_SATISFIED          0x911C
+#define GL_TIMEOUT_IGNORED              (~(uint64_t) 0)
+
+// GLsync is an opaque pointer, and GLenum and GLbitfield are unsigned int.
+struct wcore_gl_fence {
+    struct wcore_fence wcore;
+    void *sync;
+
+    void *(APIENTRY *glFenceSync)(unsigned int condition, unsigned int flags);
+    void (APIENTRY *glDeleteSync)(void *sync);
+    unsigned int (APIENTRY *glClientWaitSync)(void *sync, unsigned int flags,
+                                              uint64_t timeout);
+    void (APIENTRY *glWaitSync)(void *sync, unsigned int flags,
+                                uint64_t timeout);
+};
+
+DEFINE_CONTAINER_CAST_FUNC(wcore_gl_fence,
+                           struct wcore_gl_fence,
+                           struct wcore_fence,
+                           wcore)
+
+struct wcore_fence*
+wcore_gl_fence_create(struct wcore_platform *wc_plat,
+                      struct wcore_display *wc_dpy)
+{
+    struct wcore_gl_fence *self;
+
+    self = wcore_calloc(sizeof(*self));
+    if (!self)
+        return NULL;
+
+    if (!wcore_fence_init(&self->wcore, wc_dpy))
+        goto error;
+
+    // On WGL the entry points are only valid for the context that was
+    // current when they were resolved, so resolve them per fence.
+    self->glFenceSync = wc_plat->vtbl->get_proc_address(wc_plat, "glFenceSync");
+    self->glDeleteSync = wc_plat->vtbl->get_proc_address(wc_plat, "glDeleteSync");
+    self->glClientWaitSync = wc_plat->vtbl->get_proc_address(wc_plat, "glClientWaitSync");
+    self->glWaitSync = wc_plat->vtbl->get_proc_address(wc_plat, "glWaitSync");
+
+    if (!self->glFenceSync || !self->glDeleteSync ||
+        !self->glClientWaitSync || !self->glWaitSync) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "GL_ARB_sync is not supported");
+        goto error;
+    }
+
+    // Without a current context, or with one lacking GL_ARB_sync, the
+    // dispatch stub returns null.
+    self->sync = self->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (!self->sync) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "glFenceSync failed; either no context is current or "
+                     "it lacks GL_ARB_sync");
+        goto error;
+    }
+
+    return &self->wcore;
+
+error:
+    wcore_gl_fence_destroy(&self->wcore);
+    return NULL;
+}
+
+bool
+wcore_gl_fence_destroy(struct wcore_fence *wc_fence)
+{
+    struct wcore_gl_fence *self = wcore_gl_fence(wc_fence);
+    bool ok = true;
+
+    if (!self)
+        return ok;
+
+    if (self->sync)
+        self->glDeleteSync(self->sync);
+
+    ok &= wcore_fence_teardown(wc_fence);
+    free(self);
+    return ok;
+}
+
+bool
+wcore_gl_fence_client_wait(struct wcore_fence *wc_fence,
+                           uint64_t timeout_ns,
+                           bool *signaled)
+{
+    struct wcore_gl_fence *self = wcore_gl_fence(wc_fence);
+
+    // The flush keeps a wait on a fence of the current context from
+    // deadlocking.
+    switch (self->glClientWaitSync(self->sync, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                   timeout_ns)) {
+        case GL_ALREADY_SIGNALED:
+        case GL_CONDITION_SATISFIED:
+            *signaled = true;
+            return true;
+        case GL_TIMEOUT_EXPIRED:
+            *signaled = false;
+            return true;
+        default:
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN, "glClientWaitSync failed");
+            return false;
+    }
+}
+
+bool
+wcore_gl_fence_server_wait(struct wcore_fence *wc_fence)
+{
+    struct wcore_gl_fence *self = wcore_gl_fence(wc_fence);
+
+    self->glWaitSync(self->sync, 0, GL_TIMEOUT_IGNORED);
+    return true;
+}
@@ -30,12 +30,19 @@
 #include <stdint.h>
 #include "c99_compat.h"
 
+#include "wcore_proc_cache.h"
+
 struct wcore_config;
 struct wcore_config_attrs;
 struct wcore_context;
 struct wcore_display;
 struct wcore_platform;
+struct wcore_fence;
+struct wcore_image;
 struct wcore_window;
+struct waffle_frame;
+struct waffle_gbm_mapped_buffer;
+struct waffle_frame_timing;
 
 struct wcore_platform_vtbl {
     bool
@@ -64,6 +71,41 @@ struct wcore_platform_vtbl {
             int32_t waffle_dl,
             const char *symbol);
 
+    /// May be null, in which case the API calls dl_sym() for each symbol.
+    ///
+    /// Look up `symbols[i]` for each `syms[i]` that is null, without
+    /// emitting errors for symbols that are not found. Return the number of
+    /// non-null entries in @a syms, or -1 if the library cannot be opened.
+    int32_t
+    (*dl_sym_many)(
+            struct wcore_platform *self,
+            int32_t waffle_dl,
+            int32_t count,
+            const char *const *symbols,
+            void **syms);
+
+    /// May be null if the platform does not remember libraries that failed
+    /// to open.
+    ///
+    /// Forget those failures, so that dl_can_open() and dl_sym() try to open
+    /// the libraries again.
+    void
+    (*dl_rescan)(struct wcore_platform *self);
+
+    /// May be null.
+    ///
+    /// Return the number of rendering devices available to the platform,
+    /// or -1 on error.
+    int32_t
+    (*enumerate_devices)(struct wcore_platform *self);
+
+    /// May be null.
+    const char*
+    (*device_query_string)(
+            struct wcore_platform *self,
+            int32_t device,
+            int32_t name);
+
     struct wcore_display_vtbl {
         struct wcore_display*
         (*connect)(struct wcore_platform *platform,
@@ -117,6 +159,19 @@ struct wcore_platform_vtbl {
                   int32_t width,
                   int32_t height,
                   const intptr_t attrib_list[]);
+
+        /// May be null.
+        ///
+        /// Create a window that is never mapped onto the screen, typically
+        /// backed by a pbuffer. Same arguments as create(), except that
+        /// fullscreen (width == height == -1) is never requested.
+        struct wcore_window*
+        (*create_offscreen)(struct wcore_platform *platform,
+                            struct wcore_config *config,
+                            int32_t width,
+                            int32_t height,
+                            const intptr_t attrib_list[]);
+
         bool
         (*destroy)(struct wcore_window *window);
 
@@ -126,33 +181,153 @@ struct wcore_platform_vtbl {
         bool
         (*swap_buffers)(struct wcore_window *window);
 
+        /// May be null, in which case the API falls back to swap_buffers().
+        ///
+        /// @a rects holds @a n_rects (x, y, width, height) quadruples. If
+        /// @a n_rects is 0, the whole window is damaged.
+        bool
+        (*swap_buffers_with_damage)(struct wcore_window *window,
+                                    const int32_t *rects,
+                                    int32_t n_rects);
+
         bool
         (*resize)(struct wcore_window *window,
                   int32_t height,
                   int32_t width);
 
+        /// May be null.
+        ///
+        /// Fill @a timing for the most recently presented swap. Must not
+        /// block waiting for a presentation.
+        bool
+        (*get_frame_timing)(struct wcore_window *window,
+                            struct waffle_frame_timing *timing);
+
+        /// May be null.
+        bool
+        (*query_buffer_age)(struct wcore_window *window,
+                            int32_t *age);
+
+        /// May be null.
+        ///
+        /// Same @a rects layout as swap_buffers_with_damage().
+        bool
+        (*set_damage_region)(struct wcore_window *window,
+                             const int32_t *rects,
+                             int32_t n_rects);
+
+        /// May be null. If non-null, release_frame() must be too.
+        ///
+        /// Export the buffer presented by the most recent swap. The window
+        /// must not render into it again until release_frame().
+        bool
+        (*acquire_frame)(struct wcore_window *window,
+                         struct waffle_frame *frame);
+
+        bool
+        (*release_frame)(struct wcore_window *window,
+                         struct waffle_frame *frame);
+
+        /// May be null. GBM only. If non-null, unmap_front_buffer() must
+        /// be too.
+        bool
+        (*map_front_buffer)(struct wcore_window *window,
+                            struct waffle_gbm_mapped_buffer *buffer);
+
+        bool
+        (*unmap_front_buffer)(struct wcore_window *window,
+                              struct waffle_gbm_mapped_buffer *buffer);
+
+        /// May be null.
+        ///
+        /// Where the native call acts on the current drawable, the backend
+        /// must fail unless @a window is current on the calling thread.
+        bool
+        (*set_swap_interval)(struct wcore_window *window,
+                             int32_t interval);
+
         /// May be null.
         union waffle_native_window*
         (*get_native)(struct wcore_window *window);
     } window;
+
+    struct wcore_fence_vtbl {
+        /// May be null.
+        ///
+        /// Insert a fence into the command stream of the current context.
+        struct wcore_fence*
+        (*create)(struct wcore_platform *platform,
+                  struct wcore_display *display);
+
+        bool
+        (*destroy)(struct wcore_fence *fence);
+
+        bool
+        (*client_wait)(struct wcore_fence *fence,
+                       uint64_t timeout_ns,
+                       bool *signaled);
+
+        /// May be null.
+        bool
+        (*server_wait)(struct wcore_fence *fence);
+    } fence;
+
+    struct wcore_image_vtbl {
+        /// May be null.
+        struct wcore_image*
+        (*create_from_texture)(struct wcore_platform *platform,
+                               struct wcore_context *ctx,
+                               uint32_t texture,
+                               int32_t level);
+
+        /// May be null.
+        struct wcore_image*
+        (*create_from_renderbuffer)(struct wcore_platform *platform,
+                                    struct wcore_context *ctx,
+                                    uint32_t renderbuffer);
+
+        bool
+        (*destroy)(struct wcore_image *image);
+
+        bool
+        (*bind_texture)(struct wcore_image *image,
+                        uint32_t target);
+    } image;
 };
 
 struct wcore_platform {
     const struct wcore_platform_vtbl *vtbl;
+
+    /// Successful results of get_proc_address() and dl_sym().
+    struct wcore_proc_cache *proc_cache;
+
+    /// Set by backends whose get_proc_address() may return a different
+    /// pointer for each context, such as WGL. Their get_proc_address()
+    /// results are not cached.
+    bool proc_address_per_context;
+
+    /// If set, waffle_make_current() returns early when asked to repeat the
+    /// binding that is already current on the thread. Cleared by
+    /// WAFFLE_MAKE_CURRENT_ELISION=false in waffle_init().
+    bool make_current_elision;
 };
 
 static inline bool
 wcore_platform_init(struct wcore_platform *self)
 {
-    (void) self;
     assert(self);
-    return true;
+
+    self->make_current_elision = true;
+    self->proc_cache = wcore_proc_cache_create();
+    return self->proc_cache != NULL;
 }
 
 static inline bool
 wcore_platform_teardown(struct wcore_platform *self)
 {
-    (void) self;
     assert(self);
+
+    wcore_proc_cache_destroy(self->proc_cache);
+    self->proc_cache = NULL;
     return true;
 }
@@ -0,0 +1,304 @@
+// Copyright 2016 Google
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "threads.h"
+
+#include "wcore_proc_cache.h"
+#include "wcore_util.h"
+
+struct wcore_proc_cache_entry {
+    /// Null if the slot is empty.
+    char *name;
+    int32_t ns;
+    uint32_t hash;
+    void *proc;
+};
+
+struct wcore_proc_cache {
+    mtx_t mutex;
+
+    /// Open addressing with linear probing. The capacity is a power of 2 and
+    /// the table is kept at most 3/4 full.
+    struct wcore_proc_cache_entry *entries;
+    size_t capacity;
+    size_t count;
+
+    uint64_t hits;
+    uint64_t misses;
+};
+
+enum {
+    WCORE_PROC_CACHE_MIN_CAPACITY = 256,
+};
+
+// 32-bit FNV-1a over the namespace and the name.
+static uint32_t
+wcore_proc_cache_hash(int32_t ns, const char *name)
+{
+    uint32_t h = 2166136261u;
+
+    for (int i = 0; i < 4; ++i) {
+        h ^= ((uint32_t) ns >> (8 * i)) & 0xff;
+        h *= 16777619u;
+    }
+
+    for (const unsigned char *c = (const unsigned char *) name; *c; ++c) {
+        h ^= *c;
+        h *= 16777619u;
+    }
+
+    return h;
+}
+
+static struct wcore_proc_cache_entry*
+wcore_proc_cache_find_slot(struct wcore_proc_cache_entry *entries,
+                           size_t capacity,
+                           int32_t ns,
+                           const char *name,
+                           uint32_t hash)
+{
+    size_t mask = capacity - 1;
+
+    for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+        struct wcore_proc_cache_entry *e = &entries[i];
+
+        if (!e->name)
+            return e;
+
+        if (e->hash == hash && e->ns == ns && strcmp(e->name, name) == 0)
+            return e;
+    }
+}
+
+static bool
+wcore_proc_cache_grow(struct wcore_proc_cache *self)
+{
+    struct wcore_proc_cache_entry *entries;
+    size_t capacity;
+
+    capacity = self->capacity ? self->capacity : WCORE_PROC_CACHE_MIN_CAPACITY / 2;
+    if (!wcore_imul_size(&capacity, 2))
+        return false;
+
+    // Use calloc directly rather than wcore_calloc, because failing to grow
+    // the cache is not an error.
+    entries = calloc(capacity, sizeof(*entries));
+    if (!entries)
+        return false;
+
+    for (size_t i = 0; i < self->capacity; ++i) {
+        struct wcore_proc_cache_entry *old = &self->entries[i];
+        if (old->name)
+            *wcore_proc_cache_find_slot(entries, capacity, old->ns,
+                                        old->name, old->hash) = *old;
+    }
+
+    free(self->entries);
+    self->entries = entries;
+    self->capacity = capacity;
+    return true;
+}
+
+struct wcore_proc_cache*
+wcore_proc_cache_create(void)
+{
+    struct wcore_proc_cache *self;
+
+    self = wcore_calloc(sizeof(*self));
+    if (!self)
+        return NULL;
+
+    mtx_init(&self->mutex, mtx_plain);
+    return self;
+}
+
+void
+wcore_proc_cache_destroy(struct wcore_proc_cache *self)
+{
+    if (!self)
+        return;
+
+    for (size_t i = 0; i < self->capacity; ++i)
+        free(self->entries[i].name);
+
+    free(self->entries);
+    mtx_destroy(&self->mutex);
+    free(self);
+}
+
+// The caller must hold the mutex.
+static bool
+wcore_proc_cache_lookup_locked(struct wcore_proc_cache *self,
+                               int32_t ns,
+                               const char *name,
+                               void **proc)
+{
+    struct wcore_proc_cache_entry *e;
+
+    if (self->count == 0 || !name) {
+        self->misses++;
+        return false;
+    }
+
+    e = wcore_proc_cache_find_slot(self->entries, self->capacity, ns, name,
+                                   wcore_proc_cache_hash(ns, name));
+    if (!e->name) {
+        self->misses++;
+        return false;
+    }
+
+    self->hits++;
+    *proc = e->proc;
+    return true;
+}
+
+// The caller must hold the mutex.
+static void
+wcore_proc_cache_insert_locked(struct wcore_proc_cache *self,
+                               int32_t ns,
+                               const char *name,
+                               void *proc)
+{
+    struct wcore_proc_cache_entry *e;
+    uint32_t hash;
+    char *name_copy;
+
+    if (!name || !proc)
+        return;
+
+    if (4 * (self->count + 1) > 3 * self->capacity &&
+        !wcore_proc_cache_grow(self))
+        return;
+
+    hash = wcore_proc_cache_hash(ns, name);
+    e = wcore_proc_cache_find_slot(self->entries, self->capacity,
+                                   ns, name, hash);
+    if (e->name) {
+        // Another thread resolved the same name first.
+        e->proc = proc;
+        return;
+    }
+
+    name_copy = strdup(name);
+    if (!name_copy)
+        return;
+
+    e->name = name_copy;
+    e->ns = ns;
+    e->hash = hash;
+    e->proc = proc;
+    self->count++;
+}
+
+bool
+wcore_proc_cache_lookup(struct wcore_proc_cache *self,
+                        int32_t ns,
+                        const char *name,
+                        void **proc)
+{
+    bool found;
+
+    assert(proc);
+
+    if (!self)
+        return false;
+
+    mtx_lock(&self->mutex);
+    found = wcore_proc_cache_lookup_locked(self, ns, name, proc);
+    mtx_unlock(&self->mutex);
+
+    return found;
+}
+
+int32_t
+wcore_proc_cache_lookup_many(struct wcore_proc_cache *self,
+                             int32_t ns,
+                             int32_t count,
+                             const char *const *names,
+                             void **procs)
+{
+    int32_t found = 0;
+
+    for (int32_t i = 0; i < count; ++i)
+        procs[i] = NULL;
+
+    if (!self)
+        return 0;
+
+    mtx_lock(&self->mutex);
+    for (int32_t i = 0; i < count; ++i)
+        found += wcore_proc_cache_lookup_locked(self, ns, names[i], &procs[i]);
+    mtx_unlock(&self->mutex);
+
+    return found;
+}
+
+void
+wcore_proc_cache_insert(struct wcore_proc_cache *self,
+                        int32_t ns,
+                        const char *name,
+                        void *proc)
+{
+    if (!self)
+        return;
+
+    mtx_lock(&self->mutex);
+    wcore_proc_cache_insert_locked(self, ns, name, proc);
+    mtx_unlock(&self->mutex);
+}
+
+void
+wcore_proc_cache_insert_many(struct wcore_proc_cache *self,
+                             int32_t ns,
+                             int32_t count,
+                             const char *const *names,
+                             void *const *procs)
+{
+    if (!self)
+        return;
+
+    mtx_lock(&self->mutex);
+    for (int32_t i = 0; i < count; ++i)
+        wcore_proc_cache_insert_locked(self, ns, names[i], procs[i]);
+    mtx_unlock(&self->mutex);
+}
+
+void
+wcore_proc_cache_get_stats(struct wcore_proc_cache *self,
+                           struct waffle_symbol_cache_stats *stats)
+{
+    assert(self);
+    assert(stats);
+
+    mtx_lock(&self->mutex);
+    stats->hits = self->hits;
+    stats->misses = self->misses;
+    stats->entries = (uint32_t) self->count;
+    mtx_unlock(&self->mutex);
+}
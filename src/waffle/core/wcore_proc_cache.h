@@ -0,0 +1,95 @@
+// Copyright 2016 Google
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/// @file
+/// @brief Cache of symbol lookups, keyed by name.
+///
+/// Each platform owns one cache, which the API layer consults before calling
+/// the platform's get_proc_address() or dl_sym(). Only successful lookups are
+/// cached, so that a failed lookup still reaches the platform and emits its
+/// error. The cache is safe to use from multiple threads.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "waffle.h"
+
+struct wcore_proc_cache;
+
+/// @brief Namespace of waffle_get_proc_address() lookups.
+///
+/// waffle_dl_sym() lookups use the `WAFFLE_DL_*` enum as namespace.
+#define WCORE_PROC_CACHE_GET_PROC_ADDRESS 0
+
+struct wcore_proc_cache*
+wcore_proc_cache_create(void);
+
+void
+wcore_proc_cache_destroy(struct wcore_proc_cache *self);
+
+/// @brief Look up @a name in namespace @a ns.
+///
+/// On a hit, set @a proc and return true. Never emits an error.
+bool
+wcore_proc_cache_lookup(struct wcore_proc_cache *self,
+                        int32_t ns,
+                        const char *name,
+                        void **proc);
+
+/// @brief Remember that @a name in namespace @a ns resolves to @a proc.
+///
+/// Failure to allocate is silently ignored; the lookup is simply not cached.
+void
+wcore_proc_cache_insert(struct wcore_proc_cache *self,
+                        int32_t ns,
+                        const char *name,
+                        void *proc);
+
+/// @brief Batch variant of wcore_proc_cache_lookup(), locking only once.
+///
+/// Set `procs[i]` for each hit and null for each miss. Return the number of
+/// hits.
+int32_t
+wcore_proc_cache_lookup_many(struct wcore_proc_cache *self,
+                             int32_t ns,
+                             int32_t count,
+                             const char *const *names,
+                             void **procs);
+
+/// @brief Batch variant of wcore_proc_cache_insert(), locking only once.
+///
+/// Null entries of @a procs are skipped.
+void
+wcore_proc_cache_insert_many(struct wcore_proc_cache *self,
+                             int32_t ns,
+                             int32_t count,
+                             const char *const *names,
+                             void *const *procs);
+
+void
+wcore_proc_cache_get_stats(struct wcore_proc_cache *self,
+                           struct waffle_symbol_cache_stats *stats);
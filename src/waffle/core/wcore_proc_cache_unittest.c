@@ -0,0 +1,137 @@
+// Copyright 2016 Google
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <cmocka.h>
+
+#include "wcore_proc_cache.h"
+
+static void
+setup(void **state) {
+    *state = wcore_proc_cache_create();
+    assert_non_null(*state);
+}
+
+static void
+teardown(void **state) {
+    wcore_proc_cache_destroy(*state);
+}
+
+static void
+test_wcore_proc_cache_hit_and_miss(void **state) {
+    struct wcore_proc_cache *cache = *state;
+    struct waffle_symbol_cache_stats stats;
+    int a, b;
+    void *proc = NULL;
+
+    assert_false(wcore_proc_cache_lookup(cache, 0, "glClear", &proc));
+
+    wcore_proc_cache_insert(cache, 0, "glClear", &a);
+    wcore_proc_cache_insert(cache, 0, "glFlush", &b);
+
+    assert_true(wcore_proc_cache_lookup(cache, 0, "glClear", &proc));
+    assert_true(proc == &a);
+    assert_true(wcore_proc_cache_lookup(cache, 0, "glFlush", &proc));
+    assert_true(proc == &b);
+
+    wcore_proc_cache_get_stats(cache, &stats);
+    assert_int_equal(stats.hits, 2);
+    assert_int_equal(stats.misses, 1);
+    assert_int_equal(stats.entries, 2);
+}
+
+static void
+test_wcore_proc_cache_namespaces(void **state) {
+    struct wcore_proc_cache *cache = *state;
+    int a, b;
+    void *proc = NULL;
+
+    wcore_proc_cache_insert(cache, WAFFLE_DL_OPENGL, "glClear", &a);
+    wcore_proc_cache_insert(cache, WAFFLE_DL_OPENGL_ES2, "glClear", &b);
+
+    assert_false(wcore_proc_cache_lookup(cache, 0, "glClear", &proc));
+    assert_true(wcore_proc_cache_lookup(cache, WAFFLE_DL_OPENGL, "glClear", &proc));
+    assert_true(proc == &a);
+    assert_true(wcore_proc_cache_lookup(cache, WAFFLE_DL_OPENGL_ES2, "glClear", &proc));
+    assert_true(proc == &b);
+}
+
+static void
+test_wcore_proc_cache_null_not_cached(void **state) {
+    struct wcore_proc_cache *cache = *state;
+    struct waffle_symbol_cache_stats stats;
+    void *proc = NULL;
+
+    wcore_proc_cache_insert(cache, 0, "glBogus", NULL);
+    assert_false(wcore_proc_cache_lookup(cache, 0, "glBogus", &proc));
+
+    wcore_proc_cache_get_stats(cache, &stats);
+    assert_int_equal(stats.entries, 0);
+}
+
+static void
+test_wcore_proc_cache_grow(void **state) {
+    struct wcore_proc_cache *cache = *state;
+    struct waffle_symbol_cache_stats stats;
+    static char procs[3000];
+    char name[32];
+    void *proc;
+
+    for (int i = 0; i < 3000; ++i) {
+        snprintf(name, sizeof(name), "glFunc%d", i);
+        wcore_proc_cache_insert(cache, 0, name, &procs[i]);
+    }
+
+    for (int i = 0; i < 3000; ++i) {
+        snprintf(name, sizeof(name), "glFunc%d", i);
+        assert_true(wcore_proc_cache_lookup(cache, 0, name, &proc));
+        assert_true(proc == &procs[i]);
+    }
+
+    wcore_proc_cache_get_stats(cache, &stats);
+    assert_int_equal(stats.entries, 3000);
+    assert_int_equal(stats.hits, 3000);
+}
+
+int
+main(void) {
+    const UnitTest tests[] = {
+        #define unit_test_make(name) unit_test_setup_teardown(name, setup, teardown)
+
+        unit_test_make(test_wcore_proc_cache_hit_and_miss),
+        unit_test_make(test_wcore_proc_cache_namespaces),
+        unit_test_make(test_wcore_proc_cache_null_not_cached),
+        unit_test_make(test_wcore_proc_cache_grow),
+
+        #undef unit_test_make
+    };
+
+    return run_tests(tests);
+}
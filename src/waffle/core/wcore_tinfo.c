@@ -25,6 +25,7 @@
 
 #include <assert.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -36,6 +37,12 @@
 static once_flag wcore_tinfo_once = ONCE_FLAG_INIT;
 static tss_t wcore_tinfo_key;
 
+#ifndef __GNUC__
+static once_flag wcore_tinfo_epoch_once = ONCE_FLAG_INIT;
+static mtx_t wcore_tinfo_epoch_mutex;
+#endif
+static uint32_t wcore_tinfo_epoch;
+
 #ifdef WAFFLE_HAS_TLS
 /// @brief Thread-local storage for all of Waffle.
 ///
@@ -149,3 +156,46 @@ wcore_tinfo_get(void)
     return tinfo;
 #endif
 }
+
+void
+wcore_tinfo_clear_binding(void)
+{
+    wcore_tinfo_get()->binding.valid = false;
+}
+
+#ifndef __GNUC__
+static void
+wcore_tinfo_epoch_init(void)
+{
+    mtx_init(&wcore_tinfo_epoch_mutex, mtx_plain);
+}
+#endif
+
+uint32_t
+wcore_tinfo_binding_epoch(void)
+{
+#ifdef __GNUC__
+    return __atomic_load_n(&wcore_tinfo_epoch, __ATOMIC_ACQUIRE);
+#else
+    uint32_t epoch;
+
+    call_once(&wcore_tinfo_epoch_once, wcore_tinfo_epoch_init);
+    mtx_lock(&wcore_tinfo_epoch_mutex);
+    epoch = wcore_tinfo_epoch;
+    mtx_unlock(&wcore_tinfo_epoch_mutex);
+    return epoch;
+#endif
+}
+
+void
+wcore_tinfo_invalidate_bindings(void)
+{
+#ifdef __GNUC__
+    __atomic_add_fetch(&wcore_tinfo_epoch, 1, __ATOMIC_ACQ_REL);
+#else
+    call_once(&wcore_tinfo_epoch_once, wcore_tinfo_epoch_init);
+    mtx_lock(&wcore_tinfo_epoch_mutex);
+    wcore_tinfo_epoch++;
+    mtx_unlock(&wcore_tinfo_epoch_mutex);
+#endif
+}
@@ -25,15 +25,56 @@
 
 #pragma once
 
+#include <stdbool.h>
+#include <stdint.h>
+
+struct wcore_context;
+struct wcore_display;
 struct wcore_error_tinfo;
+struct wcore_window;
+
+/// @brief The binding made by the thread's last successful
+/// waffle_make_current().
+///
+/// The pointers are only compared, never dereferenced. The binding is stale
+/// once the epoch has moved on, see wcore_tinfo_invalidate_bindings().
+struct wcore_tinfo_binding {
+    struct wcore_display *display;
+    struct wcore_window *window;
+    struct wcore_context *context;
+    uint32_t epoch;
+    bool valid;
+};
 
 /// @brief Thread-local info for all of Waffle.
 struct wcore_tinfo {
     /// @brief Info for @ref wcore_error.
     struct wcore_error_tinfo *error;
 
+    struct wcore_tinfo_binding binding;
+
+    /// @brief Counters for waffle_get_make_current_stats().
+    uint64_t make_current_calls;
+    uint64_t make_current_rebinds;
+    uint64_t make_current_elided;
+
     bool is_init;
 };
 
 /// @brief Get the thread-local info for the current thread.
 struct wcore_tinfo* wcore_tinfo_get(void);
+
+/// @brief Get the process-wide binding epoch.
+uint32_t wcore_tinfo_binding_epoch(void);
+
+/// @brief Forget the calling thread's binding.
+///
+/// Backends that call the native MakeCurrent outside of make_current() must
+/// call this, or the next waffle_make_current() may be wrongly elided.
+void wcore_tinfo_clear_binding(void);
+
+/// @brief Mark the bindings of all threads stale.
+///
+/// Called before a display, window or context is destroyed, because a new
+/// object may later reuse its address, and before the platform is torn down.
+void wcore_tinfo_invalidate_bindings(void);
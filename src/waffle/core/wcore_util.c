@@ -85,6 +85,9 @@ wcore_enum_to_string(int32_t e)
         CASE(WAFFLE_PLATFORM_GBM);
         CASE(WAFFLE_PLATFORM_WGL);
         CASE(WAFFLE_PLATFORM_NACL);
+        CASE(WAFFLE_PLATFORM_SURFACELESS_EGL);
+        CASE(WAFFLE_PLATFORM_EGL_DEVICE);
+        CASE(WAFFLE_MAKE_CURRENT_ELISION);
         CASE(WAFFLE_CONTEXT_API);
         CASE(WAFFLE_CONTEXT_OPENGL);
         CASE(WAFFLE_CONTEXT_OPENGL_ES1);
@@ -114,6 +117,16 @@ wcore_enum_to_string(int32_t e)
         CASE(WAFFLE_WINDOW_WIDTH);
         CASE(WAFFLE_WINDOW_HEIGHT);
         CASE(WAFFLE_WINDOW_FULLSCREEN);
+        CASE(WAFFLE_WINDOW_OFFSCREEN);
+        CASE(WAFFLE_WINDOW_WAYLAND_SYNC_SWAP);
+        CASE(WAFFLE_WINDOW_GBM_BUFFERS_IN_FLIGHT);
+        CASE(WAFFLE_WINDOW_GBM_MODIFIERS);
+        CASE(WAFFLE_WINDOW_GBM_LINEAR);
+        CASE(WAFFLE_WINDOW_GBM_KMS_OUTPUT);
+        CASE(WAFFLE_WINDOW_GBM_KMS_CONNECTOR);
+        CASE(WAFFLE_DEVICE_EXTENSIONS);
+        CASE(WAFFLE_DEVICE_DRM_FILE);
+        CASE(WAFFLE_DEVICE_DRM_RENDER_NODE_FILE);
 
         default: return NULL;
 
@@ -140,8 +140,10 @@ choose_real_config(struct wegl_display *dpy,
         return NULL;
     }
 
-    // WARNING: If you resize attrib_list, then update renderable_index.
+    // WARNING: If you resize attrib_list, then update renderable_index
+    // and surface_type_index.
     const int renderable_index = 19;
+    const int surface_type_index = 21;
 
     EGLint attrib_list[] = {
         // From page 17 of the EGL 1.4 spec:
@@ -171,6 +173,12 @@ choose_real_config(struct wegl_display *dpy,
         EGL_NONE,
     };
 
+    // Surfaceless and device displays have no native windows; back all
+    // windows with pbuffers instead.
+    if (plat->egl_platform == EGL_PLATFORM_SURFACELESS_MESA ||
+        plat->egl_platform == EGL_PLATFORM_DEVICE_EXT)
+        attrib_list[surface_type_index] = EGL_PBUFFER_BIT;
+
     switch (attrs->context_api) {
         case WAFFLE_CONTEXT_OPENGL:
             attrib_list[renderable_index] = EGL_OPENGL_BIT;
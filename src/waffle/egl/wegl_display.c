@@ -44,16 +44,40 @@ get_extensions(struct wegl_display *dpy)
         return false;
     }
 
-    // waffle_is_extension_in_string() resets the error state. That's ok,
-    // however, because if we've reached this point then no error should be
-    // pending emission.
-    assert(wcore_error_get_code() == 0);
+    if (!wcore_display_set_extensions(&dpy->wcore, extensions))
+        return false;
 
-    dpy->KHR_create_context = waffle_is_extension_in_string(extensions, "EGL_KHR_create_context");
+    dpy->KHR_create_context = wcore_display_has_extension(&dpy->wcore, "EGL_KHR_create_context");
+    dpy->KHR_swap_buffers_with_damage = wcore_display_has_extension(&dpy->wcore, "EGL_KHR_swap_buffers_with_damage");
+    dpy->EXT_swap_buffers_with_damage = wcore_display_has_extension(&dpy->wcore, "EGL_EXT_swap_buffers_with_damage");
+    dpy->EXT_buffer_age = wcore_display_has_extension(&dpy->wcore, "EGL_EXT_buffer_age");
+    dpy->KHR_partial_update = wcore_display_has_extension(&dpy->wcore, "EGL_KHR_partial_update");
+    dpy->KHR_fence_sync = wcore_display_has_extension(&dpy->wcore, "EGL_KHR_fence_sync");
+    dpy->KHR_wait_sync = wcore_display_has_extension(&dpy->wcore, "EGL_KHR_wait_sync");
+    dpy->KHR_gl_texture_2D_image = wcore_display_has_extension(&dpy->wcore, "EGL_KHR_gl_texture_2D_image");
+    dpy->KHR_gl_renderbuffer_image = wcore_display_has_extension(&dpy->wcore, "EGL_KHR_gl_renderbuffer_image");
+    dpy->EXT_image_dma_buf_import_modifiers = wcore_display_has_extension(&dpy->wcore, "EGL_EXT_image_dma_buf_import_modifiers");
 
     return true;
 }
 
+static EGLDisplay
+get_platform_display(struct wegl_platform *plat, intptr_t native_display)
+{
+    if (plat->eglGetPlatformDisplay)
+        return plat->eglGetPlatformDisplay(plat->egl_platform,
+                                           (void *) native_display, NULL);
+
+    if (plat->eglGetPlatformDisplayEXT)
+        return plat->eglGetPlatformDisplayEXT(plat->egl_platform,
+                                              (void *) native_display, NULL);
+
+    wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                 "EGL implementation supports neither eglGetPlatformDisplay "
+                 "nor eglGetPlatformDisplayEXT");
+    return EGL_NO_DISPLAY;
+}
+
 /// On Linux, according to eglplatform.h, EGLNativeDisplayType and intptr_t
 /// have the same size regardless of platform.
 bool
@@ -69,10 +93,19 @@ wegl_display_init(struct wegl_display *dpy,
     if (!ok)
         goto fail;
 
-    dpy->egl = plat->eglGetDisplay((EGLNativeDisplayType) native_display);
-    if (!dpy->egl) {
-        wegl_emit_error(plat, "eglGetDisplay");
-        goto fail;
+    if (plat->egl_platform != EGL_NONE) {
+        dpy->egl = get_platform_display(plat, native_display);
+        if (!dpy->egl) {
+            if (!wcore_error_get_code())
+                wegl_emit_error(plat, "eglGetPlatformDisplay");
+            goto fail;
+        }
+    } else {
+        dpy->egl = plat->eglGetDisplay((EGLNativeDisplayType) native_display);
+        if (!dpy->egl) {
+            wegl_emit_error(plat, "eglGetDisplay");
+            goto fail;
+        }
     }
 
     ok = plat->eglInitialize(dpy->egl, &major, &minor);
@@ -104,6 +137,7 @@ wegl_display_teardown(struct wegl_display *dpy)
             wegl_emit_error(plat, "eglTerminate");
     }
 
+    ok &= wcore_display_teardown(&dpy->wcore);
     return ok;
 }
 
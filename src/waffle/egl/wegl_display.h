@@ -38,6 +38,15 @@ struct wegl_display {
     struct wcore_display wcore;
     EGLDisplay egl;
     bool KHR_create_context;
+    bool KHR_swap_buffers_with_damage;
+    bool EXT_swap_buffers_with_damage;
+    bool EXT_buffer_age;
+    bool KHR_partial_update;
+    bool KHR_fence_sync;
+    bool KHR_wait_sync;
+    bool KHR_gl_texture_2D_image;
+    bool KHR_gl_renderbuffer_image;
+    bool EXT_image_dma_buf_import_modifiers;
 };
 
 DEFINE_CONTAINER_CAST_FUNC(wegl_display,
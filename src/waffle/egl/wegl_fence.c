@@ -0,0 +1,142 @@
+// Copyright 2016 Google
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdlib.h>
+
+#include "wcore_error.h"
+
+#include "wegl_display.h"
+#include "wegl_fence.h"
+#include "wegl_imports.h"
+#include "wegl_platform.h"
+#include "wegl_util.h"
+
+struct wcore_fence*
+wegl_fence_create(struct wcore_platform *wc_plat,
+                  struct wcore_display *wc_dpy)
+{
+    struct wegl_platform *plat = wegl_platform(wc_plat);
+    struct wegl_display *dpy = wegl_display(wc_dpy);
+    struct wegl_fence *self;
+
+    if (!dpy->KHR_fence_sync || !plat->eglCreateSyncKHR) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_KHR_fence_sync is not supported");
+        return NULL;
+    }
+
+    self = wcore_calloc(sizeof(*self));
+    if (!self)
+        return NULL;
+
+    if (!wcore_fence_init(&self->wcore, wc_dpy))
+        goto error;
+
+    self->egl = plat->eglCreateSyncKHR(dpy->egl, EGL_SYNC_FENCE_KHR, NULL);
+    if (self->egl == EGL_NO_SYNC_KHR) {
+        wegl_emit_error(plat, "eglCreateSyncKHR");
+        goto error;
+    }
+
+    return &self->wcore;
+
+error:
+    wegl_fence_destroy(&self->wcore);
+    return NULL;
+}
+
+bool
+wegl_fence_destroy(struct wcore_fence *wc_fence)
+{
+    struct wegl_fence *self = wegl_fence(wc_fence);
+    bool ok = true;
+
+    if (!self)
+        return ok;
+
+    if (self->egl != EGL_NO_SYNC_KHR) {
+        struct wegl_display *dpy = wegl_display(wc_fence->display);
+        struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+
+        if (!plat->eglDestroySyncKHR(dpy->egl, self->egl)) {
+            wegl_emit_error(plat, "eglDestroySyncKHR");
+            ok = false;
+        }
+    }
+
+    ok &= wcore_fence_teardown(wc_fence);
+    free(self);
+    return ok;
+}
+
+bool
+wegl_fence_client_wait(struct wcore_fence *wc_fence,
+                       uint64_t timeout_ns,
+                       bool *signaled)
+{
+    struct wegl_fence *self = wegl_fence(wc_fence);
+    struct wegl_display *dpy = wegl_display(wc_fence->display);
+    struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+    EGLint status;
+
+    // The flush keeps a wait on a fence of the current context from
+    // deadlocking. EGL_FOREVER_KHR has the same value as
+    // WAFFLE_FENCE_TIMEOUT_INFINITE.
+    status = plat->eglClientWaitSyncKHR(dpy->egl, self->egl,
+                                        EGL_SYNC_FLUSH_COMMANDS_BIT_KHR,
+                                        timeout_ns);
+    switch (status) {
+        case EGL_CONDITION_SATISFIED_KHR:
+            *signaled = true;
+            return true;
+        case EGL_TIMEOUT_EXPIRED_KHR:
+            *signaled = false;
+            return true;
+        default:
+            wegl_emit_error(plat, "eglClientWaitSyncKHR");
+            return false;
+    }
+}
+
+bool
+wegl_fence_server_wait(struct wcore_fence *wc_fence)
+{
+    struct wegl_fence *self = wegl_fence(wc_fence);
+    struct wegl_display *dpy = wegl_display(wc_fence->display);
+    struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+
+    if (!dpy->KHR_wait_sync || !plat->eglWaitSyncKHR) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_KHR_wait_sync is not supported");
+        return false;
+    }
+
+    if (!plat->eglWaitSyncKHR(dpy->egl, self->egl, 0)) {
+        wegl_emit_error(plat, "eglWaitSyncKHR");
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,63 @@
+// Copyright 2016 Google
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include "wcore_fence.h"
+#include "wcore_util.h"
+
+struct wcore_display;
+struct wcore_platform;
+
+struct wegl_fence {
+    struct wcore_fence wcore;
+    EGLSyncKHR egl;
+};
+
+DEFINE_CONTAINER_CAST_FUNC(wegl_fence,
+                           struct wegl_fence,
+                           struct wcore_fence,
+                           wcore)
+
+struct wcore_fence*
+wegl_fence_create(struct wcore_platform *wc_plat,
+                  struct wcore_display *wc_dpy);
+
+bool
+wegl_fence_destroy(struct wcore_fence *wc_fence);
+
+bool
+wegl_fence_client_wait(struct wcore_fence *wc_fence,
+                       uint64_t timeout_ns,
+                       bool *signaled);
+
+bool
+wegl_fence_server_wait(struct wcore_fence *wc_fence);
@@ -0,0 +1,152 @@
+// Copyright 2016 Google
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdlib.h>
+
+#include "wcore_error.h"
+
+#include "wegl_context.h"
+#include "wegl_display.h"
+#include "wegl_image.h"
+#include "wegl_imports.h"
+#include "wegl_platform.h"
+#include "wegl_util.h"
+
+static struct wcore_image*
+wegl_image_create(struct wegl_platform *plat,
+                  struct wcore_context *wc_ctx,
+                  EGLenum target,
+                  uint32_t name,
+                  const EGLint *attrib_list)
+{
+    struct wegl_display *dpy = wegl_display(wc_ctx->display);
+    struct wegl_context *ctx = wegl_context(wc_ctx);
+    struct wegl_image *self;
+
+    self = wcore_calloc(sizeof(*self));
+    if (!self)
+        return NULL;
+
+    if (!wcore_image_init(&self->wcore, wc_ctx->display))
+        goto error;
+
+    self->egl = plat->eglCreateImageKHR(dpy->egl, ctx->egl, target,
+                                        (EGLClientBuffer) (uintptr_t) name,
+                                        attrib_list);
+    if (self->egl == EGL_NO_IMAGE_KHR) {
+        wegl_emit_error(plat, "eglCreateImageKHR");
+        goto error;
+    }
+
+    return &self->wcore;
+
+error:
+    wegl_image_destroy(&self->wcore);
+    return NULL;
+}
+
+struct wcore_image*
+wegl_image_create_from_texture(struct wcore_platform *wc_plat,
+                               struct wcore_context *wc_ctx,
+                               uint32_t texture,
+                               int32_t level)
+{
+    struct wegl_platform *plat = wegl_platform(wc_plat);
+    struct wegl_display *dpy = wegl_display(wc_ctx->display);
+
+    const EGLint attrib_list[] = {
+        EGL_GL_TEXTURE_LEVEL_KHR, level,
+        EGL_NONE,
+    };
+
+    if (!dpy->KHR_gl_texture_2D_image || !plat->eglCreateImageKHR) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_KHR_gl_texture_2D_image is not supported");
+        return NULL;
+    }
+
+    return wegl_image_create(plat, wc_ctx, EGL_GL_TEXTURE_2D_KHR,
+                             texture, attrib_list);
+}
+
+struct wcore_image*
+wegl_image_create_from_renderbuffer(struct wcore_platform *wc_plat,
+                                    struct wcore_context *wc_ctx,
+                                    uint32_t renderbuffer)
+{
+    struct wegl_platform *plat = wegl_platform(wc_plat);
+    struct wegl_display *dpy = wegl_display(wc_ctx->display);
+
+    if (!dpy->KHR_gl_renderbuffer_image || !plat->eglCreateImageKHR) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_KHR_gl_renderbuffer_image is not supported");
+        return NULL;
+    }
+
+    return wegl_image_create(plat, wc_ctx, EGL_GL_RENDERBUFFER_KHR,
+                             renderbuffer, NULL);
+}
+
+bool
+wegl_image_destroy(struct wcore_image *wc_image)
+{
+    struct wegl_image *self = wegl_image(wc_image);
+    bool ok = true;
+
+    if (!self)
+        return ok;
+
+    if (self->egl != EGL_NO_IMAGE_KHR) {
+        struct wegl_display *dpy = wegl_display(wc_image->display);
+        struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+
+        if (!plat->eglDestroyImageKHR(dpy->egl, self->egl)) {
+            wegl_emit_error(plat, "eglDestroyImageKHR");
+            ok = false;
+        }
+    }
+
+    ok &= wcore_image_teardown(wc_image);
+    free(self);
+    return ok;
+}
+
+bool
+wegl_image_bind_texture(struct wcore_image *wc_image, uint32_t target)
+{
+    struct wegl_image *self = wegl_image(wc_image);
+    struct wegl_platform *plat = wegl_platform(wc_image->display->platform);
+
+    // GL reports its own errors, such as a context lacking
+    // GL_OES_EGL_image, through glGetError.
+    if (!plat->glEGLImageTargetTexture2DOES) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "glEGLImageTargetTexture2DOES is not available");
+        return false;
+    }
+
+    plat->glEGLImageTargetTexture2DOES(target, self->egl);
+    return true;
+}
@@ -0,0 +1,65 @@
+// Copyright 2016 Google
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include "wcore_image.h"
+#include "wcore_util.h"
+
+struct wcore_context;
+struct wcore_platform;
+
+struct wegl_image {
+    struct wcore_image wcore;
+    EGLImageKHR egl;
+};
+
+DEFINE_CONTAINER_CAST_FUNC(wegl_image,
+                           struct wegl_image,
+                           struct wcore_image,
+                           wcore)
+
+struct wcore_image*
+wegl_image_create_from_texture(struct wcore_platform *wc_plat,
+                               struct wcore_context *wc_ctx,
+                               uint32_t texture,
+                               int32_t level);
+
+struct wcore_image*
+wegl_image_create_from_renderbuffer(struct wcore_platform *wc_plat,
+                                    struct wcore_context *wc_ctx,
+                                    uint32_t renderbuffer);
+
+bool
+wegl_image_destroy(struct wcore_image *wc_image);
+
+bool
+wegl_image_bind_texture(struct wcore_image *wc_image, uint32_t target);
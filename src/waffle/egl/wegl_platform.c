@@ -54,8 +54,108 @@ wegl_platform_teardown(struct wegl_platform *self)
     ok &= wcore_platform_teardown(&self->wcore);
     return ok;
 }
+
+static void
+setup_client_extensions(struct wegl_platform *self)
+{
+    self->client_extensions =
+        self->eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+    // Implementations lacking EGL_EXT_client_extensions return NULL and set
+    // EGL_BAD_DISPLAY. Discard the error; it's not fatal.
+    if (!self->client_extensions)
+        self->eglGetError();
+
+    if (self->eglGetProcAddress) {
+        self->eglGetPlatformDisplayEXT = (void *)
+            self->eglGetProcAddress("eglGetPlatformDisplayEXT");
+    }
+
+    // Both device extensions are client extensions, so check the string
+    // rather than trusting eglGetProcAddress, which may return a stub for
+    // any name.
+    if (waffle_is_extension_in_string(self->client_extensions,
+                                      "EGL_EXT_device_enumeration") &&
+        waffle_is_extension_in_string(self->client_extensions,
+                                      "EGL_EXT_device_query")) {
+        self->eglQueryDevicesEXT = (void *)
+            self->eglGetProcAddress("eglQueryDevicesEXT");
+        self->eglQueryDeviceStringEXT = (void *)
+            self->eglGetProcAddress("eglQueryDeviceStringEXT");
+    }
+}
+
+// Entry points of display extensions. Whether a display supports them is
+// checked by wegl_display, so a stub returned here is never called.
+static void
+setup_display_extension_funcs(struct wegl_platform *self)
+{
+    self->eglSwapBuffersWithDamageKHR = (void *)
+        self->eglGetProcAddress("eglSwapBuffersWithDamageKHR");
+    self->eglSwapBuffersWithDamageEXT = (void *)
+        self->eglGetProcAddress("eglSwapBuffersWithDamageEXT");
+    self->eglSetDamageRegionKHR = (void *)
+        self->eglGetProcAddress("eglSetDamageRegionKHR");
+    self->eglQueryDmaBufModifiersEXT = (void *)
+        self->eglGetProcAddress("eglQueryDmaBufModifiersEXT");
+    self->glEGLImageTargetTexture2DOES = (void *)
+        self->eglGetProcAddress("glEGLImageTargetTexture2DOES");
+
+    // libglvnd's libEGL exports no extension functions, so the optional
+    // symbols that dlsym() missed must come from eglGetProcAddress().
+#define PROC_EGL_SYMBOL(function)                                       \
+    if (!self->function)                                                \
+        self->function = (void *) self->eglGetProcAddress(#function);
+
+    PROC_EGL_SYMBOL(eglCreateImageKHR);
+    PROC_EGL_SYMBOL(eglDestroyImageKHR);
+    PROC_EGL_SYMBOL(eglCreateSyncKHR);
+    PROC_EGL_SYMBOL(eglDestroySyncKHR);
+    PROC_EGL_SYMBOL(eglClientWaitSyncKHR);
+    PROC_EGL_SYMBOL(eglWaitSyncKHR);
+#undef PROC_EGL_SYMBOL
+}
+
+// Platforms that may fall back to eglGetDisplay(), and the client extensions
+// that advertise them. The KHR names come with EGL 1.5; the others with
+// eglGetPlatformDisplayEXT.
+static const struct {
+    EGLenum egl_platform;
+    const char *extensions[2];
+} legacy_platforms[] = {
+    { EGL_PLATFORM_X11_KHR,     { "EGL_KHR_platform_x11",     "EGL_EXT_platform_x11"     } },
+    { EGL_PLATFORM_WAYLAND_KHR, { "EGL_KHR_platform_wayland", "EGL_EXT_platform_wayland" } },
+    { EGL_PLATFORM_GBM_KHR,     { "EGL_KHR_platform_gbm",     "EGL_MESA_platform_gbm"    } },
+};
+
+static void
+setup_platform_display(struct wegl_platform *self)
+{
+    const size_t num_platforms =
+        sizeof(legacy_platforms) / sizeof(legacy_platforms[0]);
+
+    for (size_t i = 0; i < num_platforms; i++) {
+        if (legacy_platforms[i].egl_platform != self->egl_platform)
+            continue;
+
+        if (self->eglGetPlatformDisplay || self->eglGetPlatformDisplayEXT) {
+            for (size_t j = 0; j < 2; j++) {
+                const char *ext = legacy_platforms[i].extensions[j];
+                if (waffle_is_extension_in_string(self->client_extensions,
+                                                  ext))
+                    return;
+            }
+        }
+
+        // Let eglGetDisplay() guess, steered by the EGL_PLATFORM
+        // environment variable.
+        self->egl_platform = EGL_NONE;
+        return;
+    }
+}
+
 bool
-wegl_platform_init(struct wegl_platform *self)
+wegl_platform_init(struct wegl_platform *self, EGLenum egl_platform)
 {
     bool ok;
 
@@ -64,6 +164,8 @@ wegl_platform_init(struct wegl_platform *self)
         goto error;
 
     self->eglHandle = dlopen(libEGL_filename, RTLD_LAZY | RTLD_LOCAL);
+    self->egl_platform = egl_platform;
+
     if (!self->eglHandle) {
         wcore_errorf(WAFFLE_ERROR_FATAL,
                      "dlopen(\"%s\") failed: %s",
@@ -87,12 +189,17 @@ wegl_platform_init(struct wegl_platform *self)
 
     OPTIONAL_EGL_SYMBOL(eglCreateImageKHR);
     OPTIONAL_EGL_SYMBOL(eglDestroyImageKHR);
+    OPTIONAL_EGL_SYMBOL(eglCreateSyncKHR);
+    OPTIONAL_EGL_SYMBOL(eglDestroySyncKHR);
+    OPTIONAL_EGL_SYMBOL(eglClientWaitSyncKHR);
+    OPTIONAL_EGL_SYMBOL(eglWaitSyncKHR);
 
     RETRIEVE_EGL_SYMBOL(eglMakeCurrent);
     RETRIEVE_EGL_SYMBOL(eglGetProcAddress);
 
     // display
     RETRIEVE_EGL_SYMBOL(eglGetDisplay);
+    OPTIONAL_EGL_SYMBOL(eglGetPlatformDisplay);
     RETRIEVE_EGL_SYMBOL(eglInitialize);
     RETRIEVE_EGL_SYMBOL(eglQueryString);
     RETRIEVE_EGL_SYMBOL(eglGetError);
@@ -109,12 +216,20 @@ wegl_platform_init(struct wegl_platform *self)
     // window
     RETRIEVE_EGL_SYMBOL(eglGetConfigAttrib);
     RETRIEVE_EGL_SYMBOL(eglCreateWindowSurface);
+    RETRIEVE_EGL_SYMBOL(eglCreatePbufferSurface);
     RETRIEVE_EGL_SYMBOL(eglDestroySurface);
+    RETRIEVE_EGL_SYMBOL(eglQuerySurface);
     RETRIEVE_EGL_SYMBOL(eglSwapBuffers);
+    RETRIEVE_EGL_SYMBOL(eglSwapInterval);
+    RETRIEVE_EGL_SYMBOL(eglGetCurrentSurface);
 
 #undef OPTIONAL_EGL_SYMBOL
 #undef RETRIEVE_EGL_SYMBOL
 
+    setup_client_extensions(self);
+    setup_platform_display(self);
+    setup_display_extension_funcs(self);
+
 error:
     // On failure the caller of wegl_platform_init will trigger it's own
     // destruction which will execute wegl_platform_teardown.
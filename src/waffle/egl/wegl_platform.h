@@ -31,9 +31,20 @@
 #include "wcore_platform.h"
 #include "wcore_util.h"
 
+#include "wegl_imports.h"
+
 struct wegl_platform {
     struct wcore_platform wcore;
 
+    // An EGL_PLATFORM_* enum, or EGL_NONE to use the legacy eglGetDisplay().
+    // X11, Wayland and GBM fall back to EGL_NONE during wegl_platform_init()
+    // if the implementation does not advertise the platform.
+    EGLenum egl_platform;
+
+    // Client extensions, as returned by eglQueryString(EGL_NO_DISPLAY).
+    // May be NULL if the implementation lacks EGL_EXT_client_extensions.
+    const char *client_extensions;
+
     // EGL function pointers
     void *eglHandle;
 
@@ -44,6 +55,13 @@ struct wegl_platform {
 
     // display
     EGLDisplay (*eglGetDisplay)(EGLNativeDisplayType display_id);
+    // EGL 1.5. EGLAttrib is intptr_t; spelled out for pre-1.5 headers.
+    EGLDisplay (*eglGetPlatformDisplay)(EGLenum platform,
+                                        void *native_display,
+                                        const intptr_t *attrib_list);
+    EGLDisplay (*eglGetPlatformDisplayEXT)(EGLenum platform,
+                                           void *native_display,
+                                           const EGLint *attrib_list);
     EGLBoolean (*eglInitialize)(EGLDisplay dpy, EGLint *major, EGLint *minor);
     const char * (*eglQueryString)(EGLDisplay dpy, EGLint name);
     EGLint (*eglGetError)(void);
@@ -67,11 +85,60 @@ struct wegl_platform {
     EGLSurface (*eglCreateWindowSurface)(EGLDisplay dpy, EGLConfig config,
                                          EGLNativeWindowType win,
                                          const EGLint *attrib_list);
+    EGLSurface (*eglCreatePbufferSurface)(EGLDisplay dpy, EGLConfig config,
+                                          const EGLint *attrib_list);
     EGLBoolean (*eglDestroySurface)(EGLDisplay dpy, EGLSurface surface);
+    EGLBoolean (*eglQuerySurface)(EGLDisplay dpy, EGLSurface surface,
+                                  EGLint attribute, EGLint *value);
     EGLBoolean (*eglSwapBuffers)(EGLDisplay dpy, EGLSurface surface);
+    EGLBoolean (*eglSwapInterval)(EGLDisplay dpy, EGLint interval);
+    EGLSurface (*eglGetCurrentSurface)(EGLint readdraw);
+
+    // EGL_EXT_device_enumeration, EGL_EXT_device_query
+    EGLBoolean (*eglQueryDevicesEXT)(EGLint max_devices,
+                                     EGLDeviceEXT *devices,
+                                     EGLint *num_devices);
+    const char * (*eglQueryDeviceStringEXT)(EGLDeviceEXT device,
+                                            EGLint name);
+
+    // EGL_KHR_swap_buffers_with_damage, EGL_EXT_swap_buffers_with_damage
+    EGLBoolean (*eglSwapBuffersWithDamageKHR)(EGLDisplay dpy,
+                                              EGLSurface surface,
+                                              const EGLint *rects,
+                                              EGLint n_rects);
+    EGLBoolean (*eglSwapBuffersWithDamageEXT)(EGLDisplay dpy,
+                                              EGLSurface surface,
+                                              const EGLint *rects,
+                                              EGLint n_rects);
+
+    // EGL_KHR_partial_update
+    EGLBoolean (*eglSetDamageRegionKHR)(EGLDisplay dpy,
+                                        EGLSurface surface,
+                                        EGLint *rects,
+                                        EGLint n_rects);
+
+    // EGL_KHR_fence_sync, EGL_KHR_wait_sync
+    EGLSyncKHR (*eglCreateSyncKHR)(EGLDisplay dpy, EGLenum type,
+                                   const EGLint *attrib_list);
+    EGLBoolean (*eglDestroySyncKHR)(EGLDisplay dpy, EGLSyncKHR sync);
+    EGLint (*eglClientWaitSyncKHR)(EGLDisplay dpy, EGLSyncKHR sync,
+                                   EGLint flags, EGLTimeKHR timeout);
+    EGLint (*eglWaitSyncKHR)(EGLDisplay dpy, EGLSyncKHR sync, EGLint flags);
 
     EGLImageKHR (*eglCreateImageKHR) (EGLDisplay dpy, EGLContext ctx, EGLenum target, EGLClientBuffer buffer, const EGLint *attrib_list);
     EGLBoolean (*eglDestroyImageKHR)(EGLDisplay dpy, EGLImageKHR image);
+
+    // EGL_EXT_image_dma_buf_import_modifiers. EGLuint64KHR is uint64_t.
+    EGLBoolean (*eglQueryDmaBufModifiersEXT)(EGLDisplay dpy,
+                                             EGLint format,
+                                             EGLint max_modifiers,
+                                             uint64_t *modifiers,
+                                             EGLBoolean *external_only,
+                                             EGLint *num_modifiers);
+
+    // GL_OES_EGL_image. GLenum is unsigned int.
+    void (*glEGLImageTargetTexture2DOES)(unsigned int target,
+                                         EGLImageKHR image);
 };
 
 DEFINE_CONTAINER_CAST_FUNC(wegl_platform,
@@ -83,4 +150,4 @@ bool
 wegl_platform_teardown(struct wegl_platform *self);
 
 bool
-wegl_platform_init(struct wegl_platform *self);
+wegl_platform_init(struct wegl_platform *self, EGLenum egl_platform);
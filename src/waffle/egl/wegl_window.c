@@ -23,6 +23,8 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include "wcore_error.h"
+
 #include "wegl_config.h"
 #include "wegl_display.h"
 #include "wegl_imports.h"
@@ -74,6 +76,56 @@ fail:
     return false;
 }
 
+bool
+wegl_pbuffer_init(struct wegl_window *window,
+                  struct wcore_config *wc_config,
+                  int32_t width, int32_t height)
+{
+    struct wegl_config *config = wegl_config(wc_config);
+    struct wegl_display *dpy = wegl_display(wc_config->display);
+    struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+    EGLint surface_type;
+    bool ok;
+
+    ok = wcore_window_init(&window->wcore, wc_config);
+    if (!ok)
+        goto fail;
+
+    ok = plat->eglGetConfigAttrib(dpy->egl, config->egl,
+                                  EGL_SURFACE_TYPE, &surface_type);
+    if (!ok) {
+        wegl_emit_error(plat, "eglGetConfigAttrib(EGL_SURFACE_TYPE)");
+        goto fail;
+    }
+
+    if (!(surface_type & EGL_PBUFFER_BIT)) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGLConfig does not support pbuffers");
+        goto fail;
+    }
+
+    // Pbuffers are always single-buffered, so EGL_RENDER_BUFFER is
+    // meaningless here.
+    EGLint attrib_list[] = {
+        EGL_WIDTH, width,
+        EGL_HEIGHT, height,
+        EGL_NONE,
+    };
+
+    window->egl = plat->eglCreatePbufferSurface(dpy->egl, config->egl,
+                                                attrib_list);
+    if (!window->egl) {
+        wegl_emit_error(plat, "eglCreatePbufferSurface");
+        goto fail;
+    }
+
+    return true;
+
+fail:
+    wegl_window_teardown(window);
+    return false;
+}
+
 bool
 wegl_window_teardown(struct wegl_window *window)
 {
@@ -95,14 +147,115 @@ wegl_window_teardown(struct wegl_window *window)
 
 bool
 wegl_window_swap_buffers(struct wcore_window *wc_window)
+{
+    return wegl_window_swap_buffers_with_damage(wc_window, NULL, 0);
+}
+
+bool
+wegl_window_swap_buffers_with_damage(struct wcore_window *wc_window,
+                                     const int32_t *rects,
+                                     int32_t n_rects)
 {
     struct wegl_window *window = wegl_window(wc_window);
     struct wegl_display *dpy = wegl_display(window->wcore.display);
     struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+    bool ok;
+
+    if (n_rects > 0 && dpy->KHR_swap_buffers_with_damage &&
+        plat->eglSwapBuffersWithDamageKHR) {
+        ok = plat->eglSwapBuffersWithDamageKHR(dpy->egl, window->egl,
+                                               rects, n_rects);
+        if (!ok)
+            wegl_emit_error(plat, "eglSwapBuffersWithDamageKHR");
+    } else if (n_rects > 0 && dpy->EXT_swap_buffers_with_damage &&
+               plat->eglSwapBuffersWithDamageEXT) {
+        ok = plat->eglSwapBuffersWithDamageEXT(dpy->egl, window->egl,
+                                               rects, n_rects);
+        if (!ok)
+            wegl_emit_error(plat, "eglSwapBuffersWithDamageEXT");
+    } else {
+        ok = plat->eglSwapBuffers(dpy->egl, window->egl);
+        if (!ok)
+            wegl_emit_error(plat, "eglSwapBuffers");
+    }
+
+    return ok;
+}
+
+bool
+wegl_window_query_buffer_age(struct wcore_window *wc_window, int32_t *age)
+{
+    struct wegl_window *window = wegl_window(wc_window);
+    struct wegl_display *dpy = wegl_display(window->wcore.display);
+    struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+    EGLint value;
+
+    // EGL_KHR_partial_update defines EGL_BUFFER_AGE_KHR with the same value.
+    if (!dpy->EXT_buffer_age && !dpy->KHR_partial_update) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_EXT_buffer_age is not supported");
+        return false;
+    }
+
+    if (!plat->eglQuerySurface(dpy->egl, window->egl,
+                               EGL_BUFFER_AGE_EXT, &value)) {
+        wegl_emit_error(plat, "eglQuerySurface(EGL_BUFFER_AGE_EXT)");
+        return false;
+    }
+
+    *age = value;
+    return true;
+}
+
+bool
+wegl_window_set_damage_region(struct wcore_window *wc_window,
+                              const int32_t *rects,
+                              int32_t n_rects)
+{
+    struct wegl_window *window = wegl_window(wc_window);
+    struct wegl_display *dpy = wegl_display(window->wcore.display);
+    struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+
+    if (!dpy->KHR_partial_update || !plat->eglSetDamageRegionKHR) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_KHR_partial_update is not supported");
+        return false;
+    }
+
+    // The rects are not modified, despite the prototype.
+    if (!plat->eglSetDamageRegionKHR(dpy->egl, window->egl,
+                                     (EGLint *) rects, n_rects)) {
+        wegl_emit_error(plat, "eglSetDamageRegionKHR");
+        return false;
+    }
+
+    return true;
+}
+
+bool
+wegl_window_set_swap_interval(struct wcore_window *wc_window,
+                              int32_t interval)
+{
+    struct wegl_window *window = wegl_window(wc_window);
+    struct wegl_display *dpy = wegl_display(window->wcore.display);
+    struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+
+    if (interval < 0) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL does not support adaptive swap intervals");
+        return false;
+    }
+
+    // eglSwapInterval acts on the draw surface of the current context.
+    if (plat->eglGetCurrentSurface(EGL_DRAW) != window->egl) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "window is not current on this thread");
+        return false;
+    }
 
-    bool ok = plat->eglSwapBuffers(dpy->egl, window->egl);
+    bool ok = plat->eglSwapInterval(dpy->egl, interval);
     if (!ok)
-        wegl_emit_error(plat, "eglSwapBuffers");
+        wegl_emit_error(plat, "eglSwapInterval");
 
     return ok;
 }
@@ -50,8 +50,30 @@ wegl_window_init(struct wegl_window *window,
                  struct wcore_config *wc_config,
                  intptr_t native_window);
 
+bool
+wegl_pbuffer_init(struct wegl_window *window,
+                  struct wcore_config *wc_config,
+                  int32_t width, int32_t height);
+
 bool
 wegl_window_teardown(struct wegl_window *window);
 
 bool
 wegl_window_swap_buffers(struct wcore_window *wc_window);
+
+bool
+wegl_window_swap_buffers_with_damage(struct wcore_window *wc_window,
+                                     const int32_t *rects,
+                                     int32_t n_rects);
+
+bool
+wegl_window_query_buffer_age(struct wcore_window *wc_window, int32_t *age);
+
+bool
+wegl_window_set_damage_region(struct wcore_window *wc_window,
+                              const int32_t *rects,
+                              int32_t n_rects);
+
+bool
+wegl_window_set_swap_interval(struct wcore_window *wc_window,
+                              int32_t interval);
@@ -0,0 +1,164 @@
+// Copyright 2016 Google
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "wcore_error.h"
+#include "wcore_display.h"
+
+#include "edev_display.h"
+#include "edev_platform.h"
+
+bool
+edev_display_destroy(struct wcore_display *wc_self)
+{
+    struct edev_display *self = edev_display(wc_self);
+    bool ok = true;
+
+    if (!self)
+        return ok;
+
+    ok &= wegl_display_teardown(&self->wegl);
+    free(self);
+    return ok;
+}
+
+static bool
+device_matches_path(struct edev_platform *plat, EGLDeviceEXT device,
+                    const char *path)
+{
+    static const struct {
+        EGLint name;
+        const char *extension;
+    } files[] = {
+        { EGL_DRM_DEVICE_FILE_EXT,      "EGL_EXT_device_drm" },
+        { EGL_DRM_RENDER_NODE_FILE_EXT, "EGL_EXT_device_drm_render_node" },
+    };
+    const char *exts;
+
+    exts = plat->wegl.eglQueryDeviceStringEXT(device, EGL_EXTENSIONS);
+    if (!exts)
+        return false;
+
+    for (size_t i = 0; i < sizeof(files) / sizeof(files[0]); ++i) {
+        const char *file;
+
+        if (!waffle_is_extension_in_string(exts, files[i].extension))
+            continue;
+
+        file = plat->wegl.eglQueryDeviceStringEXT(device, files[i].name);
+        if (file && strcmp(file, path) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+/// The display name is either NULL, for the first device; a decimal index
+/// into the list returned by waffle_enumerate_devices(); or the path of the
+/// device's DRM primary or render node.
+static EGLDeviceEXT
+find_device(struct edev_platform *plat, const char *name)
+{
+    if (plat->num_devices == 0) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "no EGL devices found");
+        return EGL_NO_DEVICE_EXT;
+    }
+
+    if (name == NULL)
+        return plat->devices[0];
+
+    char *end;
+    long index = strtol(name, &end, 10);
+    if (name[0] != '\0' && *end == '\0') {
+        if (index < 0 || index >= plat->num_devices) {
+            wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                         "device index %ld is out of range [0, %d)",
+                         index, plat->num_devices);
+            return EGL_NO_DEVICE_EXT;
+        }
+        return plat->devices[index];
+    }
+
+    for (EGLint i = 0; i < plat->num_devices; ++i) {
+        if (device_matches_path(plat, plat->devices[i], name))
+            return plat->devices[i];
+    }
+
+    wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                 "no EGL device matches \"%s\"", name);
+    return EGL_NO_DEVICE_EXT;
+}
+
+struct wcore_display*
+edev_display_connect(struct wcore_platform *wc_plat,
+                     const char *name)
+{
+    struct edev_platform *plat = edev_platform(wegl_platform(wc_plat));
+    struct edev_display *self;
+    bool ok = true;
+
+    self = wcore_calloc(sizeof(*self));
+    if (self == NULL)
+        return NULL;
+
+    self->egl_device = find_device(plat, name);
+    if (self->egl_device == EGL_NO_DEVICE_EXT)
+        goto error;
+
+    ok = wegl_display_init(&self->wegl, wc_plat,
+                           (intptr_t) self->egl_device);
+    if (!ok)
+        goto error;
+
+    return &self->wegl.wcore;
+
+error:
+    edev_display_destroy(&self->wegl.wcore);
+    return NULL;
+}
+
+void
+edev_display_fill_native(struct edev_display *self,
+                         struct waffle_egl_device_display *n_dpy)
+{
+    n_dpy->egl_device = self->egl_device;
+    n_dpy->egl_display = self->wegl.egl;
+}
+
+union waffle_native_display*
+edev_display_get_native(struct wcore_display *wc_self)
+{
+    struct edev_display *self = edev_display(wc_self);
+    union waffle_native_display *n_dpy;
+
+    WCORE_CREATE_NATIVE_UNION(n_dpy, egl_device);
+    if (!n_dpy)
+        return NULL;
+
+    edev_display_fill_native(self, n_dpy->egl_device);
+    return n_dpy;
+}
@@ -0,0 +1,318 @@
+// Copyright 2016 Google
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdlib.h>
+
+#include "wcore_error.h"
+
+#include "wegl_config.h"
+#include "wegl_context.h"
+#include "wegl_fence.h"
+#include "wegl_image.h"
+#include "wegl_imports.h"
+#include "wegl_platform.h"
+#include "wegl_util.h"
+
+#include "linux_platform.h"
+
+#include "edev_display.h"
+#include "edev_platform.h"
+#include "edev_window.h"
+
+static const struct wcore_platform_vtbl edev_platform_vtbl;
+
+static bool
+edev_platform_destroy(struct wcore_platform *wc_self)
+{
+    struct edev_platform *self = edev_platform(wegl_platform(wc_self));
+    bool ok = true;
+
+    if (!self)
+        return true;
+
+    if (self->linux)
+        ok &= linux_platform_destroy(self->linux);
+
+    free(self->devices);
+    ok &= wegl_platform_teardown(&self->wegl);
+    free(self);
+    return ok;
+}
+
+static bool
+edev_platform_query_devices(struct edev_platform *self)
+{
+    struct wegl_platform *plat = &self->wegl;
+    EGLint num_devices = 0;
+
+    if (!plat->eglQueryDevicesEXT || !plat->eglQueryDeviceStringEXT) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_EXT_device_enumeration and EGL_EXT_device_query "
+                     "are required");
+        return false;
+    }
+
+    if (!plat->eglQueryDevicesEXT(0, NULL, &num_devices)) {
+        wegl_emit_error(plat, "eglQueryDevicesEXT");
+        return false;
+    }
+
+    if (num_devices == 0)
+        return true;
+
+    self->devices = wcore_calloc(num_devices * sizeof(*self->devices));
+    if (!self->devices)
+        return false;
+
+    if (!plat->eglQueryDevicesEXT(num_devices, self->devices,
+                                  &self->num_devices)) {
+        wegl_emit_error(plat, "eglQueryDevicesEXT");
+        return false;
+    }
+
+    return true;
+}
+
+struct wcore_platform*
+edev_platform_create(void)
+{
+    struct edev_platform *self;
+    bool ok = true;
+
+    self = wcore_calloc(sizeof(*self));
+    if (self == NULL)
+        return NULL;
+
+    ok = wegl_platform_init(&self->wegl, EGL_PLATFORM_DEVICE_EXT);
+    if (!ok)
+        goto error;
+
+    ok = edev_platform_query_devices(self);
+    if (!ok)
+        goto error;
+
+    self->linux = linux_platform_create();
+    if (!self->linux)
+        goto error;
+
+    self->wegl.wcore.vtbl = &edev_platform_vtbl;
+    return &self->wegl.wcore;
+
+error:
+    edev_platform_destroy(&self->wegl.wcore);
+    return NULL;
+}
+
+static bool
+edev_dl_can_open(struct wcore_platform *wc_self,
+                 int32_t waffle_dl)
+{
+    struct edev_platform *self = edev_platform(wegl_platform(wc_self));
+    return linux_platform_dl_can_open(self->linux, waffle_dl);
+}
+
+static void*
+edev_dl_sym(struct wcore_platform *wc_self,
+            int32_t waffle_dl,
+            const char *name)
+{
+    struct edev_platform *self = edev_platform(wegl_platform(wc_self));
+    return linux_platform_dl_sym(self->linux, waffle_dl, name);
+}
+
+static int32_t
+edev_dl_sym_many(struct wcore_platform *wc_self,
+                 int32_t waffle_dl,
+                 int32_t count,
+                 const char *const *names,
+                 void **syms)
+{
+    struct edev_platform *self = edev_platform(wegl_platform(wc_self));
+    return linux_platform_dl_sym_many(self->linux, waffle_dl, count, names, syms);
+}
+
+static void
+edev_dl_rescan(struct wcore_platform *wc_self)
+{
+    struct edev_platform *self = edev_platform(wegl_platform(wc_self));
+    linux_platform_dl_rescan(self->linux);
+}
+
+static int32_t
+edev_enumerate_devices(struct wcore_platform *wc_self)
+{
+    struct edev_platform *self = edev_platform(wegl_platform(wc_self));
+    return self->num_devices;
+}
+
+static const char*
+edev_device_query_string(struct wcore_platform *wc_self,
+                         int32_t device,
+                         int32_t name)
+{
+    struct edev_platform *self = edev_platform(wegl_platform(wc_self));
+    struct wegl_platform *plat = &self->wegl;
+    const char *extension = NULL;
+    const char *str;
+    EGLint egl_name;
+
+    if (device < 0 || device >= self->num_devices) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "device index %d is out of range [0, %d)",
+                     device, self->num_devices);
+        return NULL;
+    }
+
+    switch (name) {
+        case WAFFLE_DEVICE_EXTENSIONS:
+            egl_name = EGL_EXTENSIONS;
+            break;
+        case WAFFLE_DEVICE_DRM_FILE:
+            egl_name = EGL_DRM_DEVICE_FILE_EXT;
+            extension = "EGL_EXT_device_drm";
+            break;
+        case WAFFLE_DEVICE_DRM_RENDER_NODE_FILE:
+            egl_name = EGL_DRM_RENDER_NODE_FILE_EXT;
+            extension = "EGL_EXT_device_drm_render_node";
+            break;
+        default:
+            wcore_error_internal("name has bad value %#x", name);
+            return NULL;
+    }
+
+    if (extension) {
+        const char *exts =
+            plat->eglQueryDeviceStringEXT(self->devices[device],
+                                          EGL_EXTENSIONS);
+        if (!waffle_is_extension_in_string(exts, extension)) {
+            wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                         "device %d does not support %s", device, extension);
+            return NULL;
+        }
+    }
+
+    str = plat->eglQueryDeviceStringEXT(self->devices[device], egl_name);
+    if (!str) {
+        wegl_emit_error(plat, "eglQueryDeviceStringEXT");
+        return NULL;
+    }
+
+    return str;
+}
+
+static union waffle_native_config*
+edev_config_get_native(struct wcore_config *wc_config)
+{
+    struct edev_display *dpy = edev_display(wc_config->display);
+    struct wegl_config *config = wegl_config(wc_config);
+    union waffle_native_config *n_config;
+
+    WCORE_CREATE_NATIVE_UNION(n_config, egl_device);
+    if (!n_config)
+        return NULL;
+
+    edev_display_fill_native(dpy, &n_config->egl_device->display);
+    n_config->egl_device->egl_config = config->egl;
+
+    return n_config;
+}
+
+static union waffle_native_context*
+edev_context_get_native(struct wcore_context *wc_ctx)
+{
+    struct edev_display *dpy = edev_display(wc_ctx->display);
+    struct wegl_context *ctx = wegl_context(wc_ctx);
+    union waffle_native_context *n_ctx;
+
+    WCORE_CREATE_NATIVE_UNION(n_ctx, egl_device);
+    if (!n_ctx)
+        return NULL;
+
+    edev_display_fill_native(dpy, &n_ctx->egl_device->display);
+    n_ctx->egl_device->egl_context = ctx->egl;
+
+    return n_ctx;
+}
+
+static const struct wcore_platform_vtbl edev_platform_vtbl = {
+    .destroy = edev_platform_destroy,
+
+    .make_current = wegl_make_current,
+    .get_proc_address = wegl_get_proc_address,
+    .dl_can_open = edev_dl_can_open,
+    .dl_sym = edev_dl_sym,
+    .dl_sym_many = edev_dl_sym_many,
+    .dl_rescan = edev_dl_rescan,
+
+    .enumerate_devices = edev_enumerate_devices,
+    .device_query_string = edev_device_query_string,
+
+    .display = {
+        .connect = edev_display_connect,
+        .destroy = edev_display_destroy,
+        .supports_context_api = wegl_display_supports_context_api,
+        .get_native = edev_display_get_native,
+    },
+
+    .config = {
+        .choose = wegl_config_choose,
+        .destroy = wegl_config_destroy,
+        .get_native = edev_config_get_native,
+    },
+
+    .context = {
+        .create = wegl_context_create,
+        .destroy = wegl_context_destroy,
+        .get_native = edev_context_get_native,
+    },
+
+    .window = {
+        .create = edev_window_create,
+        // Every device window is a pbuffer, and is therefore offscreen.
+        .create_offscreen = edev_window_create,
+        .destroy = edev_window_destroy,
+        .show = edev_window_show,
+        .swap_buffers = wegl_window_swap_buffers,
+        .swap_buffers_with_damage = wegl_window_swap_buffers_with_damage,
+        .query_buffer_age = wegl_window_query_buffer_age,
+        .set_damage_region = wegl_window_set_damage_region,
+        .set_swap_interval = wegl_window_set_swap_interval,
+        .get_native = edev_window_get_native,
+    },
+
+    .fence = {
+        .create = wegl_fence_create,
+        .destroy = wegl_fence_destroy,
+        .client_wait = wegl_fence_client_wait,
+        .server_wait = wegl_fence_server_wait,
+    },
+
+    .image = {
+        .create_from_texture = wegl_image_create_from_texture,
+        .create_from_renderbuffer = wegl_image_create_from_renderbuffer,
+        .destroy = wegl_image_destroy,
+        .bind_texture = wegl_image_bind_texture,
+    },
+};
@@ -0,0 +1,247 @@
+// Copyright 2016 Google
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <libudev.h>
+
+#include "wcore_error.h"
+
+#include "wgbm_device.h"
+#include "wgbm_platform.h"
+
+static struct wgbm_device*
+find_or_add_device(struct wgbm_platform *plat, const char *parent_syspath)
+{
+    struct wgbm_device *devices;
+
+    for (int32_t i = 0; i < plat->num_devices; i++) {
+        if (strcmp(plat->devices[i].parent_syspath, parent_syspath) == 0)
+            return &plat->devices[i];
+    }
+
+    devices = realloc(plat->devices,
+                      (plat->num_devices + 1) * sizeof(*devices));
+    if (!devices)
+        return NULL;
+
+    plat->devices = devices;
+    devices = &plat->devices[plat->num_devices];
+    memset(devices, 0, sizeof(*devices));
+
+    devices->parent_syspath = strdup(parent_syspath);
+    if (!devices->parent_syspath)
+        return NULL;
+
+    plat->num_devices++;
+    return devices;
+}
+
+/// Group the drm subsystem's primary and render nodes by the device that
+/// owns them. Scanning is best effort: a display can still be connected by
+/// path when udev is unavailable.
+void
+wgbm_device_list_scan(struct wgbm_platform *plat)
+{
+    struct udev *ud;
+    struct udev_enumerate *en;
+    struct udev_list_entry *entry;
+
+    ud = udev_new();
+    if (!ud)
+        return;
+
+    en = udev_enumerate_new(ud);
+    if (!en) {
+        udev_unref(ud);
+        return;
+    }
+
+    udev_enumerate_add_match_subsystem(en, "drm");
+    udev_enumerate_add_match_sysname(en, "card[0-9]*");
+    udev_enumerate_add_match_sysname(en, "renderD[0-9]*");
+    udev_enumerate_scan_devices(en);
+
+    udev_list_entry_foreach(entry, udev_enumerate_get_list_entry(en)) {
+        const char *syspath = udev_list_entry_get_name(entry);
+        struct udev_device *node = udev_device_new_from_syspath(ud, syspath);
+        struct udev_device *parent;
+        struct wgbm_device *device;
+        const char *devnode, *sysname;
+        char **slot;
+
+        if (!node)
+            continue;
+
+        devnode = udev_device_get_devnode(node);
+        sysname = udev_device_get_sysname(node);
+        parent = udev_device_get_parent(node);
+        if (parent)
+            syspath = udev_device_get_syspath(parent);
+
+        if (!devnode || !sysname || !syspath) {
+            udev_device_unref(node);
+            continue;
+        }
+
+        device = find_or_add_device(plat, syspath);
+        if (device) {
+            if (strncmp(sysname, "renderD", 7) == 0)
+                slot = &device->render_node;
+            else
+                slot = &device->primary_node;
+
+            if (!*slot)
+                *slot = strdup(devnode);
+        }
+
+        udev_device_unref(node);
+    }
+
+    udev_enumerate_unref(en);
+    udev_unref(ud);
+}
+
+void
+wgbm_device_list_free(struct wgbm_platform *plat)
+{
+    for (int32_t i = 0; i < plat->num_devices; i++) {
+        free(plat->devices[i].parent_syspath);
+        free(plat->devices[i].primary_node);
+        free(plat->devices[i].render_node);
+    }
+
+    free(plat->devices);
+    plat->devices = NULL;
+    plat->num_devices = 0;
+}
+
+static int
+open_node(const char *node)
+{
+    if (!node)
+        return -1;
+
+    return open(node, O_RDWR | O_CLOEXEC);
+}
+
+/// Open the device named by @a name: NULL for the first device that can be
+/// opened, a decimal index into the device list, or a path. Render nodes are
+/// preferred because they need no DRM master.
+int
+wgbm_device_open(struct wgbm_platform *plat, const char *name)
+{
+    int fd = -1;
+
+    if (name == NULL) {
+        for (int32_t i = 0; i < plat->num_devices && fd < 0; i++)
+            fd = open_node(plat->devices[i].render_node);
+
+        // If render nodes are not supported, then fall back to the card.
+        for (int32_t i = 0; i < plat->num_devices && fd < 0; i++)
+            fd = open_node(plat->devices[i].primary_node);
+
+        if (fd < 0)
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN, "open drm file for gbm failed");
+        return fd;
+    }
+
+    char *end;
+    long index = strtol(name, &end, 10);
+    if (name[0] != '\0' && *end == '\0') {
+        if (index < 0 || index >= plat->num_devices) {
+            wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                         "device index %ld is out of range [0, %d)",
+                         index, plat->num_devices);
+            return -1;
+        }
+
+        fd = open_node(plat->devices[index].render_node);
+        if (fd < 0)
+            fd = open_node(plat->devices[index].primary_node);
+
+        if (fd < 0)
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                         "failed to open gbm device %ld", index);
+        return fd;
+    }
+
+    fd = open_node(name);
+    if (fd < 0)
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "failed to open gbm device \"%s\"", name);
+    return fd;
+}
+
+int32_t
+wgbm_enumerate_devices(struct wcore_platform *wc_plat)
+{
+    struct wgbm_platform *plat = wgbm_platform(wegl_platform(wc_plat));
+    return plat->num_devices;
+}
+
+const char*
+wgbm_device_query_string(struct wcore_platform *wc_plat,
+                         int32_t device,
+                         int32_t name)
+{
+    struct wgbm_platform *plat = wgbm_platform(wegl_platform(wc_plat));
+    const char *str;
+
+    if (device < 0 || device >= plat->num_devices) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "device index %d is out of range [0, %d)",
+                     device, plat->num_devices);
+        return NULL;
+    }
+
+    switch (name) {
+        case WAFFLE_DEVICE_EXTENSIONS:
+            wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                         "gbm devices have no extension string");
+            return NULL;
+        case WAFFLE_DEVICE_DRM_FILE:
+            str = plat->devices[device].primary_node;
+            break;
+        case WAFFLE_DEVICE_DRM_RENDER_NODE_FILE:
+            str = plat->devices[device].render_node;
+            break;
+        default:
+            wcore_error_internal("name has bad value %#x", name);
+            return NULL;
+    }
+
+    if (!str) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "device %d has no such node", device);
+        return NULL;
+    }
+
+    return str;
+}
@@ -29,14 +29,11 @@
 #include <stdlib.h>
 #include <unistd.h>
 
-#include <libudev.h>
-#include <fcntl.h>
-#include <sys/types.h>
-#include <sys/stat.h>
-#include <linux/input.h>
-
 #include "wcore_error.h"
 
+#include "wegl_util.h"
+
+#include "wgbm_device.h"
 #include "wgbm_display.h"
 #include "wgbm_platform.h"
 
@@ -65,56 +62,6 @@ wgbm_display_destroy(struct wcore_display *wc_self)
     return ok;
 }
 
-int
-wgbm_get_default_fd_for_pattern(const char *pattern)
-{
-    struct udev *ud;
-    struct udev_enumerate *en;
-    struct udev_list_entry *devices, *entry;
-    const char *path, *filename;
-    struct udev_device *device;
-    int fd;
-
-    ud = udev_new();
-    en = udev_enumerate_new(ud);
-    udev_enumerate_add_match_subsystem(en, "drm");
-    udev_enumerate_add_match_sysname(en, pattern);
-    udev_enumerate_scan_devices(en);
-    devices = udev_enumerate_get_list_entry(en);
-
-    udev_list_entry_foreach(entry, devices) {
-        path = udev_list_entry_get_name(entry);
-        device = udev_device_new_from_syspath(ud, path);
-        filename = udev_device_get_devnode(device);
-        fd = open(filename, O_RDWR | O_CLOEXEC);
-        udev_device_unref(device);
-        if (fd >= 0) {
-            udev_enumerate_unref(en);
-            udev_unref(ud);
-            return fd;
-        }
-    }
-
-    udev_enumerate_unref(en);
-    udev_unref(ud);
-    return -1;
-}
-
-static int
-wgbm_get_default_fd(void)
-{
-    int fd;
-
-    // Try opening render node first
-    fd = wgbm_get_default_fd_for_pattern("renderD[0-9]*");
-    if (fd >= 0)
-        return fd;
-
-    // If render nodes are not supported, then fall back to the card
-    fd = wgbm_get_default_fd_for_pattern("card[0-9]*");
-    return fd;
-}
-
 struct wcore_display*
 wgbm_display_connect(struct wcore_platform *wc_plat,
                      const char *name)
@@ -132,20 +79,9 @@ wgbm_display_connect(struct wcore_platform *wc_plat,
         name = getenv("WAFFLE_GBM_DEVICE");
     }
 
-    if (name != NULL) {
-        fd = open(name, O_RDWR | O_CLOEXEC);
-        if (fd < 0) {
-            wcore_errorf(WAFFLE_ERROR_UNKNOWN,
-                    "failed to open gbm device \"%s\"", name);
-            goto error;
-        }
-    } else {
-        fd = wgbm_get_default_fd();
-        if (fd < 0) {
-            wcore_errorf(WAFFLE_ERROR_UNKNOWN, "open drm file for gbm failed");
-            goto error;
-        }
-    }
+    fd = wgbm_device_open(plat, name);
+    if (fd < 0)
+        goto error;
 
     dlopen("libglapi.so.0", RTLD_LAZY | RTLD_GLOBAL);
     self->gbm_device = plat->gbm_create_device(fd);
@@ -165,6 +101,65 @@ error:
     return NULL;
 }
 
+/// Get the modifiers that EGL can render to for @a format, via
+/// EGL_EXT_image_dma_buf_import_modifiers. The caller frees @a modifiers.
+/// If EGL cannot tell, this succeeds with no modifiers.
+bool
+wgbm_display_query_modifiers(struct wgbm_display *self,
+                             uint32_t format,
+                             uint64_t **modifiers,
+                             int32_t *n_modifiers)
+{
+    struct wegl_platform *plat = wegl_platform(self->wegl.wcore.platform);
+    uint64_t *mods = NULL;
+    EGLBoolean *external_only = NULL;
+    EGLint num = 0;
+    int32_t n = 0;
+
+    *modifiers = NULL;
+    *n_modifiers = 0;
+
+    if (!self->wegl.EXT_image_dma_buf_import_modifiers ||
+        !plat->eglQueryDmaBufModifiersEXT)
+        return true;
+
+    if (!plat->eglQueryDmaBufModifiersEXT(self->wegl.egl, (EGLint) format,
+                                          0, NULL, NULL, &num)) {
+        wegl_emit_error(plat, "eglQueryDmaBufModifiersEXT");
+        return false;
+    }
+
+    if (num == 0)
+        return true;
+
+    mods = wcore_calloc(num * sizeof(*mods));
+    external_only = wcore_calloc(num * sizeof(*external_only));
+    if (!mods || !external_only)
+        goto error;
+
+    if (!plat->eglQueryDmaBufModifiersEXT(self->wegl.egl, (EGLint) format,
+                                          num, mods, external_only, &num)) {
+        wegl_emit_error(plat, "eglQueryDmaBufModifiersEXT");
+        goto error;
+    }
+
+    // External-only layouts can be sampled but not rendered to.
+    for (EGLint i = 0; i < num; i++) {
+        if (!external_only[i])
+            mods[n++] = mods[i];
+    }
+
+    free(external_only);
+    *modifiers = mods;
+    *n_modifiers = n;
+    return true;
+
+error:
+    free(mods);
+    free(external_only);
+    return false;
+}
+
 void
 wgbm_display_fill_native(struct wgbm_display *self,
                          struct waffle_gbm_display *n_dpy)
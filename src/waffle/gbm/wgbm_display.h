@@ -66,5 +66,8 @@ void
 wgbm_display_fill_native(struct wgbm_display *self,
                          struct waffle_gbm_display *n_dpy);
 
-int
-wgbm_get_default_fd_for_pattern(const char *pattern);
+bool
+wgbm_display_query_modifiers(struct wgbm_display *self,
+                             uint32_t format,
+                             uint64_t **modifiers,
+                             int32_t *n_modifiers);
@@ -0,0 +1,625 @@
+// Copyright 2016 Google
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#define _POSIX_C_SOURCE 200112
+
+#include <errno.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <gbm.h>
+#include <xf86drm.h>
+#include <xf86drmMode.h>
+
+#include "wcore_error.h"
+
+#include "wgbm_kms.h"
+#include "wgbm_platform.h"
+
+/// Look up a property of a KMS object by name. Return its ID, or 0.
+static uint32_t
+find_property(struct wgbm_platform *plat,
+              int fd,
+              uint32_t object_id,
+              uint32_t object_type,
+              const char *name,
+              uint64_t *value)
+{
+    drmModeObjectPropertiesPtr props;
+    uint32_t prop_id = 0;
+
+    props = plat->drmModeObjectGetProperties(fd, object_id, object_type);
+    if (!props)
+        return 0;
+
+    for (uint32_t i = 0; i < props->count_props && !prop_id; i++) {
+        drmModePropertyPtr prop = plat->drmModeGetProperty(fd, props->props[i]);
+        if (!prop)
+            continue;
+
+        if (strcmp(prop->name, name) == 0) {
+            prop_id = prop->prop_id;
+            if (value)
+                *value = props->prop_values[i];
+        }
+
+        plat->drmModeFreeProperty(prop);
+    }
+
+    plat->drmModeFreeObjectProperties(props);
+    return prop_id;
+}
+
+static drmModeConnectorPtr
+find_connector(struct wgbm_platform *plat,
+               int fd,
+               drmModeResPtr res,
+               uint32_t connector_id)
+{
+    drmModeConnectorPtr conn;
+
+    if (connector_id) {
+        conn = plat->drmModeGetConnector(fd, connector_id);
+        if (!conn) {
+            wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                         "no KMS connector has id %u", connector_id);
+            return NULL;
+        }
+
+        if (conn->connection != DRM_MODE_CONNECTED ||
+            conn->count_modes == 0) {
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                         "KMS connector %u is not connected", connector_id);
+            plat->drmModeFreeConnector(conn);
+            return NULL;
+        }
+
+        return conn;
+    }
+
+    for (int i = 0; i < res->count_connectors; i++) {
+        conn = plat->drmModeGetConnector(fd, res->connectors[i]);
+        if (!conn)
+            continue;
+
+        if (conn->connection == DRM_MODE_CONNECTED && conn->count_modes > 0)
+            return conn;
+
+        plat->drmModeFreeConnector(conn);
+    }
+
+    wcore_errorf(WAFFLE_ERROR_UNKNOWN, "no KMS connector is connected");
+    return NULL;
+}
+
+/// Pick the connector's preferred mode for a fullscreen window, and
+/// otherwise a mode of exactly the window's size.
+static bool
+find_mode(drmModeConnectorPtr conn,
+          int32_t *width,
+          int32_t *height,
+          drmModeModeInfo *mode)
+{
+    bool fullscreen = *width == -1 && *height == -1;
+    int found = -1;
+
+    for (int i = 0; i < conn->count_modes; i++) {
+        drmModeModeInfo *m = &conn->modes[i];
+
+        if (!fullscreen && (m->hdisplay != *width || m->vdisplay != *height))
+            continue;
+
+        if (found == -1 || (m->type & DRM_MODE_TYPE_PREFERRED))
+            found = i;
+
+        if (m->type & DRM_MODE_TYPE_PREFERRED)
+            break;
+    }
+
+    if (found == -1) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "KMS connector %u has no %dx%d mode",
+                     conn->connector_id, *width, *height);
+        return false;
+    }
+
+    *mode = conn->modes[found];
+    *width = mode->hdisplay;
+    *height = mode->vdisplay;
+    return true;
+}
+
+/// Return the index in @a res of a CRTC that can drive @a conn, or -1.
+static int
+find_crtc(struct wgbm_platform *plat,
+          int fd,
+          drmModeResPtr res,
+          drmModeConnectorPtr conn)
+{
+    drmModeEncoderPtr enc;
+
+    // Keep the CRTC that already drives the connector, if any.
+    if (conn->encoder_id) {
+        enc = plat->drmModeGetEncoder(fd, conn->encoder_id);
+        if (enc) {
+            for (int i = 0; i < res->count_crtcs; i++) {
+                if (enc->crtc_id && res->crtcs[i] == enc->crtc_id) {
+                    plat->drmModeFreeEncoder(enc);
+                    return i;
+                }
+            }
+            plat->drmModeFreeEncoder(enc);
+        }
+    }
+
+    for (int e = 0; e < conn->count_encoders; e++) {
+        enc = plat->drmModeGetEncoder(fd, conn->encoders[e]);
+        if (!enc)
+            continue;
+
+        for (int i = 0; i < res->count_crtcs; i++) {
+            if (enc->possible_crtcs & (1u << i)) {
+                plat->drmModeFreeEncoder(enc);
+                return i;
+            }
+        }
+
+        plat->drmModeFreeEncoder(enc);
+    }
+
+    return -1;
+}
+
+static uint32_t
+find_primary_plane(struct wgbm_platform *plat, int fd, int crtc_index)
+{
+    drmModePlaneResPtr planes = plat->drmModeGetPlaneResources(fd);
+    uint32_t plane_id = 0;
+
+    if (!planes)
+        return 0;
+
+    for (uint32_t i = 0; i < planes->count_planes && !plane_id; i++) {
+        drmModePlanePtr plane = plat->drmModeGetPlane(fd, planes->planes[i]);
+        uint64_t type;
+
+        if (!plane)
+            continue;
+
+        if ((plane->possible_crtcs & (1u << crtc_index)) &&
+            find_property(plat, fd, plane->plane_id, DRM_MODE_OBJECT_PLANE,
+                          "type", &type) &&
+            type == DRM_PLANE_TYPE_PRIMARY)
+            plane_id = plane->plane_id;
+
+        plat->drmModeFreePlane(plane);
+    }
+
+    plat->drmModeFreePlaneResources(planes);
+    return plane_id;
+}
+
+static bool
+find_properties(struct wgbm_kms *self, struct wgbm_platform *plat)
+{
+    const struct {
+        uint32_t *id;
+        uint32_t object_id;
+        uint32_t object_type;
+        const char *name;
+    } props[] = {
+        { &self->props.connector_crtc_id, self->connector_id, DRM_MODE_OBJECT_CONNECTOR, "CRTC_ID" },
+        { &self->props.crtc_mode_id,      self->crtc_id,      DRM_MODE_OBJECT_CRTC,      "MODE_ID" },
+        { &self->props.crtc_active,       self->crtc_id,      DRM_MODE_OBJECT_CRTC,      "ACTIVE"  },
+        { &self->props.plane_fb_id,       self->plane_id,     DRM_MODE_OBJECT_PLANE,     "FB_ID"   },
+        { &self->props.plane_crtc_id,     self->plane_id,     DRM_MODE_OBJECT_PLANE,     "CRTC_ID" },
+        { &self->props.plane_src_x,       self->plane_id,     DRM_MODE_OBJECT_PLANE,     "SRC_X"   },
+        { &self->props.plane_src_y,       self->plane_id,     DRM_MODE_OBJECT_PLANE,     "SRC_Y"   },
+        { &self->props.plane_src_w,       self->plane_id,     DRM_MODE_OBJECT_PLANE,     "SRC_W"   },
+        { &self->props.plane_src_h,       self->plane_id,     DRM_MODE_OBJECT_PLANE,     "SRC_H"   },
+        { &self->props.plane_crtc_x,      self->plane_id,     DRM_MODE_OBJECT_PLANE,     "CRTC_X"  },
+        { &self->props.plane_crtc_y,      self->plane_id,     DRM_MODE_OBJECT_PLANE,     "CRTC_Y"  },
+        { &self->props.plane_crtc_w,      self->plane_id,     DRM_MODE_OBJECT_PLANE,     "CRTC_W"  },
+        { &self->props.plane_crtc_h,      self->plane_id,     DRM_MODE_OBJECT_PLANE,     "CRTC_H"  },
+    };
+
+    for (size_t i = 0; i < sizeof(props) / sizeof(props[0]); i++) {
+        *props[i].id = find_property(plat, self->fd, props[i].object_id,
+                                     props[i].object_type, props[i].name,
+                                     NULL);
+        if (!*props[i].id) {
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                         "KMS object %u lacks property %s",
+                         props[i].object_id, props[i].name);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// Select a connector, mode, CRTC and primary plane for a window. If
+/// @a connector_id is 0, use the first connected connector. A fullscreen
+/// window, sized -1x-1, gets the connector's preferred mode; other windows
+/// need a mode of their exact size.
+bool
+wgbm_kms_init(struct wgbm_kms *self,
+              struct wgbm_platform *plat,
+              int fd,
+              uint32_t connector_id,
+              int32_t *width,
+              int32_t *height)
+{
+    drmModeResPtr res = NULL;
+    drmModeConnectorPtr conn = NULL;
+    int crtc_index;
+    bool ok = false;
+
+    memset(self, 0, sizeof(*self));
+    self->fd = fd;
+
+    if (!plat->drmModeAtomicCommit) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "KMS output requires libdrm");
+        return false;
+    }
+
+    if (plat->drmGetNodeTypeFromFd(fd) != DRM_NODE_PRIMARY) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "KMS output requires the display to be connected to a "
+                     "DRM primary node; pass its path, such as /dev/dri/card0 "
+                     "or a device's WAFFLE_DEVICE_DRM_FILE, to "
+                     "waffle_display_connect()");
+        return false;
+    }
+
+    if (plat->drmSetClientCap(fd, DRM_CLIENT_CAP_UNIVERSAL_PLANES, 1) ||
+        plat->drmSetClientCap(fd, DRM_CLIENT_CAP_ATOMIC, 1)) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "DRM driver does not support atomic modesetting");
+        return false;
+    }
+
+    res = plat->drmModeGetResources(fd);
+    if (!res) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "drmModeGetResources failed");
+        return false;
+    }
+
+    conn = find_connector(plat, fd, res, connector_id);
+    if (!conn)
+        goto out;
+
+    self->connector_id = conn->connector_id;
+
+    if (!find_mode(conn, width, height, &self->mode))
+        goto out;
+
+    crtc_index = find_crtc(plat, fd, res, conn);
+    if (crtc_index < 0) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "no CRTC can drive KMS connector %u",
+                     self->connector_id);
+        goto out;
+    }
+
+    self->crtc_id = res->crtcs[crtc_index];
+    self->plane_id = find_primary_plane(plat, fd, crtc_index);
+    if (!self->plane_id) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "KMS CRTC %u has no primary plane", self->crtc_id);
+        goto out;
+    }
+
+    if (!find_properties(self, plat))
+        goto out;
+
+    if (plat->drmModeCreatePropertyBlob(fd, &self->mode, sizeof(self->mode),
+                                        &self->mode_blob_id)) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "drmModeCreatePropertyBlob failed");
+        goto out;
+    }
+
+    ok = true;
+
+out:
+    if (conn)
+        plat->drmModeFreeConnector(conn);
+    plat->drmModeFreeResources(res);
+    return ok;
+}
+
+static void
+page_flip_handler(int fd,
+                  unsigned int sequence,
+                  unsigned int tv_sec,
+                  unsigned int tv_usec,
+                  void *user_data)
+{
+    struct wgbm_kms *self = user_data;
+    self->flip_pending = false;
+}
+
+/// Block until the last committed page flip has completed. Events for
+/// other windows on the same device are dispatched along the way.
+static bool
+wait_for_flip(struct wgbm_kms *self, struct wgbm_platform *plat)
+{
+    drmEventContext evctx = {
+        .version = 2,
+        .page_flip_handler = page_flip_handler,
+    };
+
+    while (self->flip_pending) {
+        struct pollfd pfd = {
+            .fd = self->fd,
+            .events = POLLIN,
+        };
+
+        if (poll(&pfd, 1, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                         "poll on DRM device failed: %s", strerror(errno));
+            return false;
+        }
+
+        if (plat->drmHandleEvent(self->fd, &evctx) != 0) {
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN, "drmHandleEvent failed");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+struct wgbm_kms_fb {
+    int fd;
+    uint32_t fb_id;
+    int (*drmModeRmFB)(int fd, uint32_t buffer_id);
+};
+
+static void
+destroy_fb(struct gbm_bo *bo, void *data)
+{
+    struct wgbm_kms_fb *fb = data;
+
+    fb->drmModeRmFB(fb->fd, fb->fb_id);
+    free(fb);
+}
+
+/// Get the framebuffer of @a bo, creating it on first use. It lives as long
+/// as the bo, which the gbm_surface recycles.
+static uint32_t
+get_fb(struct wgbm_kms *self, struct wgbm_platform *plat, struct gbm_bo *bo)
+{
+    struct wgbm_kms_fb *fb = plat->gbm_bo_get_user_data(bo);
+    uint32_t handles[4] = { 0 };
+    uint32_t pitches[4] = { 0 };
+    uint32_t offsets[4] = { 0 };
+    uint64_t modifiers[4] = { 0 };
+    uint64_t modifier = DRM_FORMAT_MOD_INVALID;
+    bool per_plane = plat->gbm_bo_get_plane_count &&
+                     plat->gbm_bo_get_handle_for_plane &&
+                     plat->gbm_bo_get_stride_for_plane &&
+                     plat->gbm_bo_get_offset;
+    int num_planes = per_plane ? plat->gbm_bo_get_plane_count(bo) : 1;
+    uint32_t fb_id;
+    int ret;
+
+    if (fb)
+        return fb->fb_id;
+
+    if (num_planes < 1 || num_planes > 4) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "gbm_bo has unsupported plane count %d", num_planes);
+        return 0;
+    }
+
+    if (plat->gbm_bo_get_modifier)
+        modifier = plat->gbm_bo_get_modifier(bo);
+
+    for (int i = 0; i < num_planes; i++) {
+        if (per_plane) {
+            handles[i] = plat->gbm_bo_get_handle_for_plane(bo, i).u32;
+            pitches[i] = plat->gbm_bo_get_stride_for_plane(bo, i);
+            offsets[i] = plat->gbm_bo_get_offset(bo, i);
+        }
+        else {
+            handles[i] = plat->gbm_bo_get_handle(bo).u32;
+            pitches[i] = plat->gbm_bo_get_stride(bo);
+        }
+        modifiers[i] = modifier;
+    }
+
+    if (modifier != DRM_FORMAT_MOD_INVALID) {
+        ret = plat->drmModeAddFB2WithModifiers(self->fd,
+                                               plat->gbm_bo_get_width(bo),
+                                               plat->gbm_bo_get_height(bo),
+                                               plat->gbm_bo_get_format(bo),
+                                               handles, pitches, offsets,
+                                               modifiers, &fb_id,
+                                               DRM_MODE_FB_MODIFIERS);
+    }
+    else {
+        ret = plat->drmModeAddFB2(self->fd,
+                                  plat->gbm_bo_get_width(bo),
+                                  plat->gbm_bo_get_height(bo),
+                                  plat->gbm_bo_get_format(bo),
+                                  handles, pitches, offsets, &fb_id, 0);
+    }
+
+    if (ret) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "failed to create KMS framebuffer: %s", strerror(-ret));
+        return 0;
+    }
+
+    fb = wcore_calloc(sizeof(*fb));
+    if (!fb) {
+        plat->drmModeRmFB(self->fd, fb_id);
+        return 0;
+    }
+
+    fb->fd = self->fd;
+    fb->fb_id = fb_id;
+    fb->drmModeRmFB = plat->drmModeRmFB;
+    plat->gbm_bo_set_user_data(bo, fb, destroy_fb);
+    return fb_id;
+}
+
+static int
+add_property(struct wgbm_platform *plat,
+             drmModeAtomicReqPtr req,
+             uint32_t object_id,
+             uint32_t prop_id,
+             uint64_t value)
+{
+    return plat->drmModeAtomicAddProperty(req, object_id, prop_id, value) < 0;
+}
+
+/// Queue @a bo for scanout with a non-blocking atomic commit. Only the
+/// previous flip is waited for, so rendering overlaps with scanout.
+bool
+wgbm_kms_present(struct wgbm_kms *self,
+                 struct wgbm_platform *plat,
+                 struct gbm_bo *bo)
+{
+    uint32_t flags = DRM_MODE_ATOMIC_NONBLOCK | DRM_MODE_PAGE_FLIP_EVENT;
+    drmModeAtomicReqPtr req;
+    uint32_t fb_id;
+    int err = 0;
+
+    fb_id = get_fb(self, plat, bo);
+    if (!fb_id)
+        return false;
+
+    if (!wait_for_flip(self, plat))
+        return false;
+
+    req = plat->drmModeAtomicAlloc();
+    if (!req) {
+        wcore_error(WAFFLE_ERROR_BAD_ALLOC);
+        return false;
+    }
+
+    if (!self->mode_set) {
+        uint32_t w = self->mode.hdisplay;
+        uint32_t h = self->mode.vdisplay;
+
+        flags |= DRM_MODE_ATOMIC_ALLOW_MODESET;
+        err |= add_property(plat, req, self->connector_id,
+                            self->props.connector_crtc_id, self->crtc_id);
+        err |= add_property(plat, req, self->crtc_id,
+                            self->props.crtc_mode_id, self->mode_blob_id);
+        err |= add_property(plat, req, self->crtc_id,
+                            self->props.crtc_active, 1);
+        err |= add_property(plat, req, self->plane_id,
+                            self->props.plane_crtc_id, self->crtc_id);
+
+        // Source coordinates are 16.16 fixed point.
+        err |= add_property(plat, req, self->plane_id,
+                            self->props.plane_src_x, 0);
+        err |= add_property(plat, req, self->plane_id,
+                            self->props.plane_src_y, 0);
+        err |= add_property(plat, req, self->plane_id,
+                            self->props.plane_src_w, (uint64_t) w << 16);
+        err |= add_property(plat, req, self->plane_id,
+                            self->props.plane_src_h, (uint64_t) h << 16);
+        err |= add_property(plat, req, self->plane_id,
+                            self->props.plane_crtc_x, 0);
+        err |= add_property(plat, req, self->plane_id,
+                            self->props.plane_crtc_y, 0);
+        err |= add_property(plat, req, self->plane_id,
+                            self->props.plane_crtc_w, w);
+        err |= add_property(plat, req, self->plane_id,
+                            self->props.plane_crtc_h, h);
+    }
+
+    err |= add_property(plat, req, self->plane_id,
+                        self->props.plane_fb_id, fb_id);
+
+    if (!err)
+        err = plat->drmModeAtomicCommit(self->fd, req, flags, self);
+
+    plat->drmModeAtomicFree(req);
+
+    if (err) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "drmModeAtomicCommit failed: %s", strerror(errno));
+        return false;
+    }
+
+    self->mode_set = true;
+    self->flip_pending = true;
+    return true;
+}
+
+/// Wait for the last flip, then switch the output off so that no
+/// framebuffer of the window is still scanned out when it is destroyed.
+bool
+wgbm_kms_teardown(struct wgbm_kms *self,
+                  struct wgbm_platform *plat)
+{
+    drmModeAtomicReqPtr req;
+    bool ok = true;
+    int err = 0;
+
+    ok &= wait_for_flip(self, plat);
+
+    if (self->mode_set) {
+        req = plat->drmModeAtomicAlloc();
+        if (req) {
+            err |= add_property(plat, req, self->plane_id,
+                                self->props.plane_fb_id, 0);
+            err |= add_property(plat, req, self->plane_id,
+                                self->props.plane_crtc_id, 0);
+            err |= add_property(plat, req, self->connector_id,
+                                self->props.connector_crtc_id, 0);
+            err |= add_property(plat, req, self->crtc_id,
+                                self->props.crtc_mode_id, 0);
+            err |= add_property(plat, req, self->crtc_id,
+                                self->props.crtc_active, 0);
+            if (!err)
+                err = plat->drmModeAtomicCommit(self->fd, req,
+                                                DRM_MODE_ATOMIC_ALLOW_MODESET,
+                                                NULL);
+            plat->drmModeAtomicFree(req);
+        }
+
+        if (!req || err) {
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                         "failed to disable KMS output");
+            ok = false;
+        }
+    }
+
+    if (self->mode_blob_id)
+        plat->drmModeDestroyPropertyBlob(self->fd, self->mode_blob_id);
+
+    return ok;
+}
@@ -0,0 +1,86 @@
+// Copyright 2016 Google
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <xf86drmMode.h>
+
+struct gbm_bo;
+struct wgbm_platform;
+
+/// Scanout of a GBM window on one KMS connector, with atomic commits.
+struct wgbm_kms {
+    int fd;
+
+    uint32_t connector_id;
+    uint32_t crtc_id;
+    uint32_t plane_id;
+
+    drmModeModeInfo mode;
+    uint32_t mode_blob_id;
+
+    /// Property IDs, looked up by name.
+    struct {
+        uint32_t connector_crtc_id;
+        uint32_t crtc_mode_id;
+        uint32_t crtc_active;
+        uint32_t plane_fb_id;
+        uint32_t plane_crtc_id;
+        uint32_t plane_src_x;
+        uint32_t plane_src_y;
+        uint32_t plane_src_w;
+        uint32_t plane_src_h;
+        uint32_t plane_crtc_x;
+        uint32_t plane_crtc_y;
+        uint32_t plane_crtc_w;
+        uint32_t plane_crtc_h;
+    } props;
+
+    /// Whether the first commit has set the mode.
+    bool mode_set;
+
+    /// Whether a page flip has been committed whose event has not arrived.
+    bool flip_pending;
+};
+
+bool
+wgbm_kms_init(struct wgbm_kms *self,
+              struct wgbm_platform *plat,
+              int fd,
+              uint32_t connector_id,
+              int32_t *width,
+              int32_t *height);
+
+bool
+wgbm_kms_teardown(struct wgbm_kms *self,
+                  struct wgbm_platform *plat);
+
+bool
+wgbm_kms_present(struct wgbm_kms *self,
+                 struct wgbm_platform *plat,
+                 struct gbm_bo *bo);
@@ -34,15 +34,19 @@
 
 #include "wegl_config.h"
 #include "wegl_context.h"
+#include "wegl_fence.h"
+#include "wegl_image.h"
 #include "wegl_platform.h"
 #include "wegl_util.h"
 
 #include "wgbm_config.h"
+#include "wgbm_device.h"
 #include "wgbm_display.h"
 #include "wgbm_platform.h"
 #include "wgbm_window.h"
 
 static const char *libgbm_filename = "libgbm.so.1";
+static const char *libdrm_filename = "libdrm.so.2";
 
 static const struct wcore_platform_vtbl wgbm_platform_vtbl;
 
@@ -57,6 +61,8 @@ wgbm_platform_teardown(struct wgbm_platform *self)
 
     unsetenv("EGL_PLATFORM");
 
+    wgbm_device_list_free(self);
+
     if (self->linux)
         ok &= linux_platform_destroy(self->linux);
 
@@ -70,6 +76,16 @@ wgbm_platform_teardown(struct wgbm_platform *self)
         }
     }
 
+    if (self->drmHandle) {
+        error = dlclose(self->drmHandle);
+        if (error) {
+            ok &= false;
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                         "dlclose(\"%s\") failed: %s",
+                         libdrm_filename, dlerror());
+        }
+    }
+
     ok &= wegl_platform_teardown(&self->wegl);
     return ok;
 }
@@ -92,7 +108,7 @@ wgbm_platform_init(struct wgbm_platform *self)
 {
     bool ok = true;
 
-    ok = wegl_platform_init(&self->wegl);
+    ok = wegl_platform_init(&self->wegl, EGL_PLATFORM_GBM_KHR);
     if (!ok)
         goto error;
 
@@ -116,12 +132,39 @@ wgbm_platform_init(struct wgbm_platform *self)
     GBM_FUNCTIONS(RETRIEVE_GBM_SYMBOL);
 #undef RETRIEVE_GBM_SYMBOL
 
+#define RETRIEVE_OPTIONAL_GBM_SYMBOL(type, function, args)                     \
+    self->function = dlsym(self->gbmHandle, #function);
+
+    GBM_OPTIONAL_FUNCTIONS(RETRIEVE_OPTIONAL_GBM_SYMBOL);
+#undef RETRIEVE_OPTIONAL_GBM_SYMBOL
+
+    // Without libdrm, everything but KMS output still works.
+    self->drmHandle = dlopen(libdrm_filename, RTLD_LAZY | RTLD_LOCAL);
+    if (self->drmHandle) {
+        bool has_drm = true;
+
+#define RETRIEVE_DRM_SYMBOL(type, function, args)                              \
+        self->function = dlsym(self->drmHandle, #function);                    \
+        has_drm &= self->function != NULL;
+
+        DRM_FUNCTIONS(RETRIEVE_DRM_SYMBOL);
+#undef RETRIEVE_DRM_SYMBOL
+
+        if (!has_drm) {
+#define CLEAR_DRM_SYMBOL(type, function, args) self->function = NULL;
+            DRM_FUNCTIONS(CLEAR_DRM_SYMBOL);
+#undef CLEAR_DRM_SYMBOL
+        }
+    }
+
     self->linux = linux_platform_create();
     if (!self->linux)
         goto error;
 
     setenv("EGL_PLATFORM", "drm", true);
 
+    wgbm_device_list_scan(self);
+
     self->wegl.wcore.vtbl = &wgbm_platform_vtbl;
     return true;
 
@@ -161,6 +204,24 @@ wgbm_dl_sym(struct wcore_platform *wc_self,
     return linux_platform_dl_sym(self->linux, waffle_dl, name);
 }
 
+int32_t
+wgbm_dl_sym_many(struct wcore_platform *wc_self,
+                 int32_t waffle_dl,
+                 int32_t count,
+                 const char *const *names,
+                 void **syms)
+{
+    struct wgbm_platform *self = wgbm_platform(wegl_platform(wc_self));
+    return linux_platform_dl_sym_many(self->linux, waffle_dl, count, names, syms);
+}
+
+void
+wgbm_dl_rescan(struct wcore_platform *wc_self)
+{
+    struct wgbm_platform *self = wgbm_platform(wegl_platform(wc_self));
+    linux_platform_dl_rescan(self->linux);
+}
+
 static union waffle_native_context*
 wgbm_context_get_native(struct wcore_context *wc_ctx)
 {
@@ -185,6 +246,10 @@ static const struct wcore_platform_vtbl wgbm_platform_vtbl = {
     .get_proc_address = wegl_get_proc_address,
     .dl_can_open = wgbm_dl_can_open,
     .dl_sym = wgbm_dl_sym,
+    .dl_sym_many = wgbm_dl_sym_many,
+    .dl_rescan = wgbm_dl_rescan,
+    .enumerate_devices = wgbm_enumerate_devices,
+    .device_query_string = wgbm_device_query_string,
 
     .display = {
         .connect = wgbm_display_connect,
@@ -210,6 +275,28 @@ static const struct wcore_platform_vtbl wgbm_platform_vtbl = {
         .destroy = wgbm_window_destroy,
         .show = wgbm_window_show,
         .swap_buffers = wgbm_window_swap_buffers,
+        .swap_buffers_with_damage = wgbm_window_swap_buffers_with_damage,
+        .query_buffer_age = wegl_window_query_buffer_age,
+        .set_damage_region = wegl_window_set_damage_region,
+        .acquire_frame = wgbm_window_acquire_frame,
+        .release_frame = wgbm_window_release_frame,
+        .map_front_buffer = wgbm_window_map_front_buffer,
+        .unmap_front_buffer = wgbm_window_unmap_front_buffer,
+        .set_swap_interval = wegl_window_set_swap_interval,
         .get_native = wgbm_window_get_native,
     },
+
+    .fence = {
+        .create = wegl_fence_create,
+        .destroy = wegl_fence_destroy,
+        .client_wait = wegl_fence_client_wait,
+        .server_wait = wegl_fence_server_wait,
+    },
+
+    .image = {
+        .create_from_texture = wegl_image_create_from_texture,
+        .create_from_renderbuffer = wegl_image_create_from_renderbuffer,
+        .destroy = wegl_image_destroy,
+        .bind_texture = wegl_image_bind_texture,
+    },
 };
@@ -28,6 +28,8 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <gbm.h>
+#include <xf86drm.h>
+#include <xf86drmMode.h>
 
 #undef linux
 
@@ -50,19 +52,79 @@
     f(uint32_t            , gbm_bo_get_stride            , (struct gbm_bo *bo)) \
     f(uint32_t            , gbm_bo_get_format            , (struct gbm_bo *bo)) \
     f(union gbm_bo_handle , gbm_bo_get_handle            , (struct gbm_bo *bo)) \
-    f(struct gbm_device * , gbm_bo_get_device            , (struct gbm_bo *bo))
+    f(struct gbm_device * , gbm_bo_get_device            , (struct gbm_bo *bo)) \
+    f(void                , gbm_bo_set_user_data         , (struct gbm_bo *bo, void *data, void (*destroy_user_data)(struct gbm_bo *, void *))) \
+    f(void *              , gbm_bo_get_user_data         , (struct gbm_bo *bo))
+
+// Newer than the oldest libgbm we support. These may be null.
+#define GBM_OPTIONAL_FUNCTIONS(f) \
+    f(int                 , gbm_bo_get_plane_count       , (struct gbm_bo *bo)) \
+    f(int                 , gbm_bo_get_fd_for_plane      , (struct gbm_bo *bo, int plane)) \
+    f(uint32_t            , gbm_bo_get_stride_for_plane  , (struct gbm_bo *bo, int plane)) \
+    f(uint32_t            , gbm_bo_get_offset            , (struct gbm_bo *bo, int plane)) \
+    f(union gbm_bo_handle , gbm_bo_get_handle_for_plane  , (struct gbm_bo *bo, int plane)) \
+    f(uint64_t            , gbm_bo_get_modifier          , (struct gbm_bo *bo)) \
+    f(void *              , gbm_bo_map                   , (struct gbm_bo *bo, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t flags, uint32_t *stride, void **map_data)) \
+    f(void                , gbm_bo_unmap                 , (struct gbm_bo *bo, void *map_data)) \
+    f(struct gbm_surface *, gbm_surface_create_with_modifiers, (struct gbm_device *gbm, uint32_t width, uint32_t height, uint32_t format, const uint64_t *modifiers, const unsigned int count))
+
+// libdrm is needed only for KMS output. These are all null if any is missing.
+#define DRM_FUNCTIONS(f) \
+    f(int                       , drmSetClientCap             , (int fd, uint64_t capability, uint64_t value)) \
+    f(int                       , drmGetNodeTypeFromFd        , (int fd)) \
+    f(int                       , drmHandleEvent              , (int fd, drmEventContextPtr evctx)) \
+    f(drmModeResPtr             , drmModeGetResources         , (int fd)) \
+    f(void                      , drmModeFreeResources        , (drmModeResPtr ptr)) \
+    f(drmModeConnectorPtr       , drmModeGetConnector         , (int fd, uint32_t connector_id)) \
+    f(void                      , drmModeFreeConnector        , (drmModeConnectorPtr ptr)) \
+    f(drmModeEncoderPtr         , drmModeGetEncoder           , (int fd, uint32_t encoder_id)) \
+    f(void                      , drmModeFreeEncoder          , (drmModeEncoderPtr ptr)) \
+    f(drmModePlaneResPtr        , drmModeGetPlaneResources    , (int fd)) \
+    f(void                      , drmModeFreePlaneResources   , (drmModePlaneResPtr ptr)) \
+    f(drmModePlanePtr           , drmModeGetPlane             , (int fd, uint32_t plane_id)) \
+    f(void                      , drmModeFreePlane            , (drmModePlanePtr ptr)) \
+    f(drmModeObjectPropertiesPtr, drmModeObjectGetProperties  , (int fd, uint32_t object_id, uint32_t object_type)) \
+    f(void                      , drmModeFreeObjectProperties , (drmModeObjectPropertiesPtr ptr)) \
+    f(drmModePropertyPtr        , drmModeGetProperty          , (int fd, uint32_t property_id)) \
+    f(void                      , drmModeFreeProperty         , (drmModePropertyPtr ptr)) \
+    f(int                       , drmModeCreatePropertyBlob   , (int fd, const void *data, size_t size, uint32_t *id)) \
+    f(int                       , drmModeDestroyPropertyBlob  , (int fd, uint32_t id)) \
+    f(drmModeAtomicReqPtr       , drmModeAtomicAlloc          , (void)) \
+    f(void                      , drmModeAtomicFree           , (drmModeAtomicReqPtr req)) \
+    f(int                       , drmModeAtomicAddProperty    , (drmModeAtomicReqPtr req, uint32_t object_id, uint32_t property_id, uint64_t value)) \
+    f(int                       , drmModeAtomicCommit         , (int fd, drmModeAtomicReqPtr req, uint32_t flags, void *user_data)) \
+    f(int                       , drmModeAddFB2               , (int fd, uint32_t width, uint32_t height, uint32_t pixel_format, const uint32_t bo_handles[4], const uint32_t pitches[4], const uint32_t offsets[4], uint32_t *buf_id, uint32_t flags)) \
+    f(int                       , drmModeAddFB2WithModifiers  , (int fd, uint32_t width, uint32_t height, uint32_t pixel_format, const uint32_t bo_handles[4], const uint32_t pitches[4], const uint32_t offsets[4], const uint64_t modifier[4], uint32_t *buf_id, uint32_t flags)) \
+    f(int                       , drmModeRmFB                 , (int fd, uint32_t buffer_id))
+
+#ifndef DRM_FORMAT_MOD_INVALID
+#define DRM_FORMAT_MOD_INVALID ((1ULL << 56) - 1)
+#endif
 
 struct linux_platform;
+struct wgbm_device;
 
 struct wgbm_platform {
     struct wegl_platform wegl;
     struct linux_platform *linux;
 
+    /// Scanned once, at platform creation, with udev.
+    struct wgbm_device *devices;
+    int32_t num_devices;
+
     // GBM function pointers
     void *gbmHandle;
 
 #define DECLARE(type, function, args) type (*function) args;
     GBM_FUNCTIONS(DECLARE)
+    GBM_OPTIONAL_FUNCTIONS(DECLARE)
+#undef DECLARE
+
+    // libdrm function pointers
+    void *drmHandle;
+
+#define DECLARE(type, function, args) type (*function) args;
+    DRM_FUNCTIONS(DECLARE)
 #undef DECLARE
 };
 
@@ -91,3 +153,13 @@ void*
 wgbm_dl_sym(struct wcore_platform *wc_self,
             int32_t waffle_dl,
             const char *name);
+
+int32_t
+wgbm_dl_sym_many(struct wcore_platform *wc_self,
+                 int32_t waffle_dl,
+                 int32_t count,
+                 const char *const *names,
+                 void **syms);
+
+void
+wgbm_dl_rescan(struct wcore_platform *wc_self);
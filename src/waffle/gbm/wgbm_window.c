@@ -25,6 +25,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 #include <gbm.h>
 
@@ -37,24 +38,126 @@
 
 #include "wgbm_config.h"
 #include "wgbm_display.h"
+#include "wgbm_kms.h"
 #include "wgbm_platform.h"
 #include "wgbm_window.h"
 
+static bool
+wgbm_window_is_held(struct wgbm_window *self, struct gbm_bo *bo)
+{
+    for (int32_t i = 0; i < self->n_held; i++) {
+        if (self->held[i] == bo)
+            return true;
+    }
+
+    return false;
+}
+
+/// Free @a self, which may be partially initialized by wgbm_window_create().
+static bool
+wgbm_window_teardown(struct wgbm_window *self, struct wgbm_platform *plat)
+{
+    bool ok = true;
+
+    // Stop scanout before the framebuffers go away with the gbm_surface.
+    if (self->kms) {
+        ok &= wgbm_kms_teardown(self->kms, plat);
+        free(self->kms);
+    }
+
+    // wegl_window_init() cleans up after itself when it fails, so there is
+    // something to tear down only once the EGL surface exists.
+    if (self->wegl.egl)
+        ok &= wegl_window_teardown(&self->wegl);
+
+    if (self->gbm_surface) {
+        for (int32_t i = 0; i < self->n_bos; i++)
+            plat->gbm_surface_release_buffer(self->gbm_surface, self->bos[i]);
+
+        plat->gbm_surface_destroy(self->gbm_surface);
+    }
+
+    free(self);
+    return ok;
+}
+
 bool
 wgbm_window_destroy(struct wcore_window *wc_self)
 {
-    struct wcore_platform *wc_plat = wc_self->display->platform;
-    struct wgbm_platform *plat = wgbm_platform(wegl_platform(wc_plat));
     struct wgbm_window *self = wgbm_window(wc_self);
-    bool ok = true;
 
     if (!self)
-        return ok;
+        return true;
 
-    ok &= wegl_window_teardown(&self->wegl);
-    plat->gbm_surface_destroy(self->gbm_surface);
-    free(self);
-    return ok;
+    // Destroying the gbm_surface would free the held buffers under the
+    // user.
+    if (self->n_held > 0) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "window still has %d acquired frames or mapped buffers",
+                     (int) self->n_held);
+        return false;
+    }
+
+    struct wcore_platform *wc_plat = wc_self->display->platform;
+    return wgbm_window_teardown(self, wgbm_platform(wegl_platform(wc_plat)));
+}
+
+static struct gbm_surface*
+wgbm_window_create_surface(struct wgbm_platform *plat,
+                           struct wgbm_display *dpy,
+                           int32_t width,
+                           int32_t height,
+                           uint32_t format,
+                           uint32_t flags,
+                           const uint64_t *modifier_list)
+{
+    struct gbm_surface *surface;
+    const uint64_t *modifiers = modifier_list;
+    uint64_t *queried = NULL;
+    int32_t n_modifiers = 0;
+
+    if (!modifier_list) {
+        surface = plat->gbm_surface_create(dpy->gbm_device,
+                                           width, height, format, flags);
+        if (!surface)
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN, "gbm_surface_create failed");
+        return surface;
+    }
+
+    while (modifier_list[n_modifiers] != DRM_FORMAT_MOD_INVALID)
+        n_modifiers++;
+
+    if (n_modifiers > 0 && !plat->gbm_surface_create_with_modifiers) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "libgbm lacks gbm_surface_create_with_modifiers");
+        return NULL;
+    }
+
+    // An empty list lets the driver choose among all the layouts that EGL
+    // can render to.
+    if (n_modifiers == 0) {
+        if (!wgbm_display_query_modifiers(dpy, format,
+                                          &queried, &n_modifiers))
+            return NULL;
+        modifiers = queried;
+    }
+
+    // Without modifier support, the implicit layout is the driver's choice.
+    if (n_modifiers == 0 || !plat->gbm_surface_create_with_modifiers) {
+        free(queried);
+        return wgbm_window_create_surface(plat, dpy, width, height, format,
+                                          flags, NULL);
+    }
+
+    surface = plat->gbm_surface_create_with_modifiers(dpy->gbm_device,
+                                                      width, height, format,
+                                                      modifiers, n_modifiers);
+    if (!surface)
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "gbm_surface_create_with_modifiers failed");
+
+    free(queried);
+    return surface;
 }
 
 struct wcore_window*
@@ -67,35 +170,160 @@ wgbm_window_create(struct wcore_platform *wc_plat,
     struct wgbm_display *dpy = wgbm_display(wc_config->display);
     struct wgbm_platform *plat = wgbm_platform(wegl_platform(wc_plat));
     struct wgbm_window *self;
+    intptr_t *attrib_list_filtered;
+    intptr_t buffers_in_flight = WAFFLE_DONT_CARE;
+    intptr_t modifier_list = 0;
+    intptr_t linear = 0;
+    intptr_t kms_output = 0;
+    intptr_t kms_connector = WAFFLE_DONT_CARE;
+    uint32_t gbm_flags = GBM_BO_USE_RENDERING;
     uint32_t gbm_format;
     bool ok = true;
 
-    if (width == -1 && height == -1) {
+    attrib_list_filtered = wcore_attrib_list_copy(attrib_list);
+    wcore_attrib_list_pop(attrib_list_filtered,
+                          WAFFLE_WINDOW_GBM_BUFFERS_IN_FLIGHT,
+                          &buffers_in_flight);
+    wcore_attrib_list_pop(attrib_list_filtered,
+                          WAFFLE_WINDOW_GBM_MODIFIERS,
+                          &modifier_list);
+    wcore_attrib_list_pop(attrib_list_filtered,
+                          WAFFLE_WINDOW_GBM_LINEAR, &linear);
+    wcore_attrib_list_pop(attrib_list_filtered,
+                          WAFFLE_WINDOW_GBM_KMS_OUTPUT, &kms_output);
+    wcore_attrib_list_pop(attrib_list_filtered,
+                          WAFFLE_WINDOW_GBM_KMS_CONNECTOR, &kms_connector);
+    if (linear == WAFFLE_DONT_CARE)
+        linear = 0; // default
+    if (kms_output == WAFFLE_DONT_CARE)
+        kms_output = 0; // default
+
+    // One buffer is on screen while the next waits for its page flip.
+    if (buffers_in_flight == WAFFLE_DONT_CARE)
+        buffers_in_flight = kms_output == 1 ? 2 : 1; // default
+
+    if (kms_output != 0 && kms_output != 1) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "WAFFLE_WINDOW_GBM_KMS_OUTPUT has bad value 0x%x. "
+                     "Must be true(1), false(0), or WAFFLE_DONT_CARE(-1)",
+                     (int) kms_output);
+        free(attrib_list_filtered);
+        return NULL;
+    }
+
+    if (kms_connector != WAFFLE_DONT_CARE &&
+        (!kms_output || kms_connector <= 0 || kms_connector > UINT32_MAX)) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "WAFFLE_WINDOW_GBM_KMS_CONNECTOR has bad value %d. "
+                     "Must be a KMS connector id, and requires "
+                     "WAFFLE_WINDOW_GBM_KMS_OUTPUT",
+                     (int) kms_connector);
+        free(attrib_list_filtered);
+        return NULL;
+    }
+
+    if (kms_output && buffers_in_flight < 2) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "WAFFLE_WINDOW_GBM_KMS_OUTPUT requires "
+                     "WAFFLE_WINDOW_GBM_BUFFERS_IN_FLIGHT >= 2");
+        free(attrib_list_filtered);
+        return NULL;
+    }
+
+    if (width == -1 && height == -1 && !kms_output) {
         wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
-                     "fullscreen window not supported");
+                     "fullscreen window not supported without "
+                     "WAFFLE_WINDOW_GBM_KMS_OUTPUT");
+        free(attrib_list_filtered);
+        return NULL;
+    }
+
+    if (buffers_in_flight < 1 ||
+        buffers_in_flight > WGBM_WINDOW_MAX_BUFFERS_IN_FLIGHT) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "WAFFLE_WINDOW_GBM_BUFFERS_IN_FLIGHT has bad value %d. "
+                     "Must be in the range [1, %d] or WAFFLE_DONT_CARE(-1)",
+                     (int) buffers_in_flight,
+                     WGBM_WINDOW_MAX_BUFFERS_IN_FLIGHT);
+        free(attrib_list_filtered);
+        return NULL;
+    }
+
+    if (linear != 0 && linear != 1) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "WAFFLE_WINDOW_GBM_LINEAR has bad value 0x%x. "
+                     "Must be true(1), false(0), or WAFFLE_DONT_CARE(-1)",
+                     (int) linear);
+        free(attrib_list_filtered);
+        return NULL;
+    }
+
+    if (linear && modifier_list) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "WAFFLE_WINDOW_GBM_LINEAR and WAFFLE_WINDOW_GBM_MODIFIERS "
+                     "are mutually exclusive");
+        free(attrib_list_filtered);
+        return NULL;
+    }
+
+    // gbm_surface_create_with_modifiers() takes no usage flags, so it would
+    // drop GBM_BO_USE_SCANOUT and could pick a layout the plane cannot scan
+    // out.
+    if (kms_output && modifier_list) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "WAFFLE_WINDOW_GBM_MODIFIERS cannot be combined with "
+                     "WAFFLE_WINDOW_GBM_KMS_OUTPUT");
+        free(attrib_list_filtered);
         return NULL;
     }
 
-    if (wcore_attrib_list_length(attrib_list) > 0) {
-        wcore_error_bad_attribute(attrib_list[0]);
+    if (wcore_attrib_list_length(attrib_list_filtered) > 0) {
+        wcore_error_bad_attribute(attrib_list_filtered[0]);
+        free(attrib_list_filtered);
         return NULL;
     }
 
+    free(attrib_list_filtered);
+
     self = wcore_calloc(sizeof(*self));
     if (self == NULL)
         return NULL;
 
+    self->buffers_in_flight = buffers_in_flight;
+
+    // Linear buffers can be mapped without a detiling blit.
+    if (linear)
+        gbm_flags |= GBM_BO_USE_LINEAR;
+
+    if (kms_output) {
+        self->kms = wcore_calloc(sizeof(*self->kms));
+        if (!self->kms)
+            goto error;
+
+        // Picks the mode, and so the size of a fullscreen window.
+        ok = wgbm_kms_init(self->kms, plat,
+                           plat->gbm_device_get_fd(dpy->gbm_device),
+                           kms_connector == WAFFLE_DONT_CARE
+                               ? 0 : (uint32_t) kms_connector,
+                           &width, &height);
+        if (!ok) {
+            free(self->kms);
+            self->kms = NULL;
+            goto error;
+        }
+
+        gbm_flags |= GBM_BO_USE_SCANOUT;
+    }
+
     gbm_format = wgbm_config_get_gbm_format(wc_plat, wc_config->display,
                                             wc_config);
     assert(gbm_format != 0);
-    self->gbm_surface = plat->gbm_surface_create(dpy->gbm_device,
-                                                 width, height, gbm_format,
-                                                 GBM_BO_USE_RENDERING);
-    if (!self->gbm_surface) {
-        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
-                     "gbm_surface_create failed");
+    self->gbm_surface =
+        wgbm_window_create_surface(plat, dpy, width, height,
+                                   gbm_format, gbm_flags,
+                                   (const uint64_t *) modifier_list);
+    if (!self->gbm_surface)
         goto error;
-    }
 
     ok = wegl_window_init(&self->wegl, wc_config,
                           (intptr_t) self->gbm_surface);
@@ -105,7 +333,7 @@ wgbm_window_create(struct wcore_platform *wc_plat,
     return &self->wegl.wcore;
 
 error:
-    wgbm_window_destroy(&self->wegl.wcore);
+    wgbm_window_teardown(self, plat);
     return NULL;
 }
 
@@ -113,17 +341,30 @@ error:
 bool
 wgbm_window_show(struct wcore_window *wc_self)
 {
+    struct wgbm_window *self = wgbm_window(wc_self);
+
+    // KMS output starts with the next swap.
+    self->shown = true;
     return true;
 }
 
 
 bool
 wgbm_window_swap_buffers(struct wcore_window *wc_self)
+{
+    return wgbm_window_swap_buffers_with_damage(wc_self, NULL, 0);
+}
+
+
+bool
+wgbm_window_swap_buffers_with_damage(struct wcore_window *wc_self,
+                                     const int32_t *rects,
+                                     int32_t n_rects)
 {
     struct wcore_platform *wc_plat = wc_self->display->platform;
     struct wgbm_platform *plat = wgbm_platform(wegl_platform(wc_plat));
 
-    if (!wegl_window_swap_buffers(wc_self))
+    if (!wegl_window_swap_buffers_with_damage(wc_self, rects, n_rects))
         return false;
 
     struct wgbm_window *self = wgbm_window(wc_self);
@@ -131,7 +372,241 @@ wgbm_window_swap_buffers(struct wcore_window *wc_self)
     if (!bo)
         return false;
 
+    // This waits for the previous page flip, so the oldest buffer is off
+    // screen by the time it is released below.
+    if (self->kms && self->shown && !wgbm_kms_present(self->kms, plat, bo)) {
+        plat->gbm_surface_release_buffer(self->gbm_surface, bo);
+        return false;
+    }
+
+    // Release by age, keeping the newest buffers_in_flight buffers locked
+    // so the consumer can still read them while the GPU renders ahead.
+    if (self->n_bos == self->buffers_in_flight) {
+        struct gbm_bo *oldest = self->bos[0];
+
+        memmove(&self->bos[0], &self->bos[1],
+                (self->n_bos - 1) * sizeof(self->bos[0]));
+        self->n_bos--;
+
+        if (!wgbm_window_is_held(self, oldest))
+            plat->gbm_surface_release_buffer(self->gbm_surface, oldest);
+    }
+
+    self->bos[self->n_bos++] = bo;
+    return true;
+}
+
+
+static void
+wgbm_window_close_frame_fds(struct waffle_frame *frame)
+{
+    for (int i = 0; i < WAFFLE_FRAME_MAX_PLANES; i++) {
+        if (frame->fds[i] >= 0)
+            close(frame->fds[i]);
+        frame->fds[i] = -1;
+    }
+}
+
+
+static bool
+wgbm_window_export_bo(struct wgbm_platform *plat,
+                      struct gbm_bo *bo,
+                      struct waffle_frame *frame)
+{
+    // libgbm gained the per-plane queries together. Older versions only
+    // know single-plane buffers.
+    bool per_plane = plat->gbm_bo_get_plane_count &&
+                     plat->gbm_bo_get_stride_for_plane &&
+                     plat->gbm_bo_get_offset;
+    int num_planes = per_plane ? plat->gbm_bo_get_plane_count(bo) : 1;
+
+    if (num_planes < 1 || num_planes > WAFFLE_FRAME_MAX_PLANES) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "gbm_bo has unsupported plane count %d", num_planes);
+        return false;
+    }
+
+    memset(frame, 0, sizeof(*frame));
+    for (int i = 0; i < WAFFLE_FRAME_MAX_PLANES; i++)
+        frame->fds[i] = -1;
+
+    frame->width = plat->gbm_bo_get_width(bo);
+    frame->height = plat->gbm_bo_get_height(bo);
+    frame->format = plat->gbm_bo_get_format(bo);
+    frame->modifier = plat->gbm_bo_get_modifier
+                    ? plat->gbm_bo_get_modifier(bo)
+                    : DRM_FORMAT_MOD_INVALID;
+    frame->num_planes = num_planes;
+
+    for (int i = 0; i < num_planes; i++) {
+        // Without gbm_bo_get_fd_for_plane(), all planes live in one bo.
+        if (plat->gbm_bo_get_fd_for_plane)
+            frame->fds[i] = plat->gbm_bo_get_fd_for_plane(bo, i);
+        else
+            frame->fds[i] = plat->gbm_bo_get_fd(bo);
+
+        if (frame->fds[i] < 0) {
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                         "failed to export plane %d of gbm_bo as dma-buf", i);
+            wgbm_window_close_frame_fds(frame);
+            return false;
+        }
+
+        if (per_plane) {
+            frame->strides[i] = plat->gbm_bo_get_stride_for_plane(bo, i);
+            frame->offsets[i] = plat->gbm_bo_get_offset(bo, i);
+        }
+        else {
+            frame->strides[i] = plat->gbm_bo_get_stride(bo);
+            frame->offsets[i] = 0;
+        }
+    }
+
+    frame->priv = bo;
+    return true;
+}
+
+
+/// Get the buffer of the most recent swap, unless the user already has it.
+static struct gbm_bo*
+wgbm_window_peek_front_bo(struct wgbm_window *self)
+{
+    if (self->n_bos == 0 ||
+        wgbm_window_is_held(self, self->bos[self->n_bos - 1])) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "no frame has been presented since the last acquire");
+        return NULL;
+    }
+
+    if (self->n_held == WGBM_WINDOW_MAX_HELD_BUFFERS) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "too many frames are acquired or mapped");
+        return NULL;
+    }
+
+    return self->bos[self->n_bos - 1];
+}
+
+
+/// The user now holds the front buffer. It stays in the ring until a later
+/// swap drops it.
+static void
+wgbm_window_take_front_bo(struct wgbm_window *self)
+{
+    self->held[self->n_held++] = self->bos[self->n_bos - 1];
+}
+
+
+/// The user is done with @a bo. Return it to the gbm_surface unless the
+/// ring still needs it.
+static void
+wgbm_window_give_back_bo(struct wgbm_platform *plat,
+                         struct wgbm_window *self,
+                         struct gbm_bo *bo)
+{
+    for (int32_t i = 0; i < self->n_held; i++) {
+        if (self->held[i] == bo) {
+            self->held[i] = self->held[--self->n_held];
+            break;
+        }
+    }
+
+    for (int32_t i = 0; i < self->n_bos; i++) {
+        if (self->bos[i] == bo)
+            return;
+    }
+
     plat->gbm_surface_release_buffer(self->gbm_surface, bo);
+}
+
+
+bool
+wgbm_window_acquire_frame(struct wcore_window *wc_self,
+                          struct waffle_frame *frame)
+{
+    struct wcore_platform *wc_plat = wc_self->display->platform;
+    struct wgbm_platform *plat = wgbm_platform(wegl_platform(wc_plat));
+    struct wgbm_window *self = wgbm_window(wc_self);
+
+    struct gbm_bo *bo = wgbm_window_peek_front_bo(self);
+
+    if (!bo)
+        return false;
+
+    if (!wgbm_window_export_bo(plat, bo, frame))
+        return false;
+
+    wgbm_window_take_front_bo(self);
+    return true;
+}
+
+
+bool
+wgbm_window_release_frame(struct wcore_window *wc_self,
+                          struct waffle_frame *frame)
+{
+    struct wcore_platform *wc_plat = wc_self->display->platform;
+    struct wgbm_platform *plat = wgbm_platform(wegl_platform(wc_plat));
+    struct wgbm_window *self = wgbm_window(wc_self);
+    struct gbm_bo *bo = frame->priv;
+
+    wgbm_window_close_frame_fds(frame);
+    frame->priv = NULL;
+
+    wgbm_window_give_back_bo(plat, self, bo);
+    return true;
+}
+
+
+bool
+wgbm_window_map_front_buffer(struct wcore_window *wc_self,
+                             struct waffle_gbm_mapped_buffer *buffer)
+{
+    struct wcore_platform *wc_plat = wc_self->display->platform;
+    struct wgbm_platform *plat = wgbm_platform(wegl_platform(wc_plat));
+    struct wgbm_window *self = wgbm_window(wc_self);
+    struct gbm_bo *bo;
+
+    if (!plat->gbm_bo_map || !plat->gbm_bo_unmap) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "libgbm lacks gbm_bo_map");
+        return false;
+    }
+
+    bo = wgbm_window_peek_front_bo(self);
+    if (!bo)
+        return false;
+
+    memset(buffer, 0, sizeof(*buffer));
+    buffer->width = plat->gbm_bo_get_width(bo);
+    buffer->height = plat->gbm_bo_get_height(bo);
+    buffer->format = plat->gbm_bo_get_format(bo);
+    buffer->data = plat->gbm_bo_map(bo, 0, 0, buffer->width, buffer->height,
+                                    GBM_BO_TRANSFER_READ, &buffer->stride,
+                                    &buffer->map_data);
+    if (!buffer->data) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "gbm_bo_map failed");
+        return false;
+    }
+
+    buffer->priv = bo;
+    wgbm_window_take_front_bo(self);
+    return true;
+}
+
+
+bool
+wgbm_window_unmap_front_buffer(struct wcore_window *wc_self,
+                               struct waffle_gbm_mapped_buffer *buffer)
+{
+    struct wcore_platform *wc_plat = wc_self->display->platform;
+    struct wgbm_platform *plat = wgbm_platform(wegl_platform(wc_plat));
+    struct wgbm_window *self = wgbm_window(wc_self);
+    struct gbm_bo *bo = buffer->priv;
+
+    plat->gbm_bo_unmap(bo, buffer->map_data);
+    wgbm_window_give_back_bo(plat, self, bo);
+    memset(buffer, 0, sizeof(*buffer));
     return true;
 }
 
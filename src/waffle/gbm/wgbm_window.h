@@ -29,12 +29,41 @@
 
 #include "wegl_window.h"
 
+// Mesa's gbm_surface has four color buffers, and one must stay free to
+// render into.
+#define WGBM_WINDOW_MAX_BUFFERS_IN_FLIGHT 3
+
+// The user cannot hold more buffers than the gbm_surface has.
+#define WGBM_WINDOW_MAX_HELD_BUFFERS 4
+
 struct wcore_platform;
+struct wgbm_kms;
+struct gbm_bo;
 struct gbm_surface;
+struct waffle_frame;
+struct waffle_gbm_mapped_buffer;
 
 struct wgbm_window {
     struct gbm_surface *gbm_surface;
     struct wegl_window wegl;
+
+    /// Buffers locked by recent swaps, oldest first. Each swap drops the
+    /// oldest once more than buffers_in_flight are held. With KMS output,
+    /// the two newest are the ones on screen and waiting to flip.
+    struct gbm_bo *bos[WGBM_WINDOW_MAX_BUFFERS_IN_FLIGHT];
+    int32_t n_bos;
+    int32_t buffers_in_flight;
+
+    /// Buffers handed to the user by acquire_frame() or map_front_buffer().
+    /// A buffer returns to the gbm_surface once it is in neither array, so
+    /// one that is still in the ring, such as a scanout buffer, stays
+    /// locked after the user releases it.
+    struct gbm_bo *held[WGBM_WINDOW_MAX_HELD_BUFFERS];
+    int32_t n_held;
+
+    /// Null unless the window scans out to a KMS connector.
+    struct wgbm_kms *kms;
+    bool shown;
 };
 
 static inline struct wgbm_window*
@@ -65,5 +94,26 @@ wgbm_window_show(struct wcore_window *wc_self);
 bool
 wgbm_window_swap_buffers(struct wcore_window *wc_self);
 
+bool
+wgbm_window_swap_buffers_with_damage(struct wcore_window *wc_self,
+                                     const int32_t *rects,
+                                     int32_t n_rects);
+
+bool
+wgbm_window_acquire_frame(struct wcore_window *wc_self,
+                          struct waffle_frame *frame);
+
+bool
+wgbm_window_release_frame(struct wcore_window *wc_self,
+                          struct waffle_frame *frame);
+
+bool
+wgbm_window_map_front_buffer(struct wcore_window *wc_self,
+                             struct waffle_gbm_mapped_buffer *buffer);
+
+bool
+wgbm_window_unmap_front_buffer(struct wcore_window *wc_self,
+                               struct waffle_gbm_mapped_buffer *buffer);
+
 union waffle_native_window*
 wgbm_window_get_native(struct wcore_window *wc_self);
@@ -61,9 +61,12 @@ glx_display_set_extensions(struct glx_display *self)
         return false;
     }
 
-    self->ARB_create_context                     = waffle_is_extension_in_string(s, "GLX_ARB_create_context");
-    self->ARB_create_context_profile             = waffle_is_extension_in_string(s, "GLX_ARB_create_context_profile");
-    self->EXT_create_context_es_profile          = waffle_is_extension_in_string(s, "GLX_EXT_create_context_es_profile");
+    if (!wcore_display_set_extensions(&self->wcore, s))
+        return false;
+
+    self->ARB_create_context                     = wcore_display_has_extension(&self->wcore, "GLX_ARB_create_context");
+    self->ARB_create_context_profile             = wcore_display_has_extension(&self->wcore, "GLX_ARB_create_context_profile");
+    self->EXT_create_context_es_profile          = wcore_display_has_extension(&self->wcore, "GLX_EXT_create_context_es_profile");
 
     // The GLX_EXT_create_context_es2_profile spec, version 4 2012/03/28,
     // states that GLX_EXT_create_context_es_profile is an alias of
@@ -76,9 +79,14 @@ glx_display_set_extensions(struct glx_display *self)
     else {
         // Assume that GLX does not implement version 3 of the extension, in
         // which case the ES contexts GLX is capable of creating is ES2.
-        self->EXT_create_context_es2_profile = waffle_is_extension_in_string(s, "GLX_EXT_create_context_es2_profile");
+        self->EXT_create_context_es2_profile = wcore_display_has_extension(&self->wcore, "GLX_EXT_create_context_es2_profile");
     }
 
+    self->EXT_buffer_age                         = wcore_display_has_extension(&self->wcore, "GLX_EXT_buffer_age");
+    self->EXT_swap_control                       = wcore_display_has_extension(&self->wcore, "GLX_EXT_swap_control");
+    self->EXT_swap_control_tear                  = wcore_display_has_extension(&self->wcore, "GLX_EXT_swap_control_tear");
+    self->MESA_swap_control                      = wcore_display_has_extension(&self->wcore, "GLX_MESA_swap_control");
+
     return true;
 }
 
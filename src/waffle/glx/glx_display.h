@@ -48,6 +48,10 @@ struct glx_display {
     bool ARB_create_context_profile;
     bool EXT_create_context_es_profile;
     bool EXT_create_context_es2_profile;
+    bool EXT_buffer_age;
+    bool EXT_swap_control;
+    bool EXT_swap_control_tear;
+    bool MESA_swap_control;
 };
 
 DEFINE_CONTAINER_CAST_FUNC(glx_display,
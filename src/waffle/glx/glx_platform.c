@@ -27,6 +27,7 @@
 #include <dlfcn.h>
 
 #include "wcore_error.h"
+#include "wcore_gl_fence.h"
 
 #include "linux_platform.h"
 
@@ -112,6 +113,11 @@ glx_platform_create(void)
     RETRIEVE_GLX_SYMBOL(glXChooseFBConfig);
 
     RETRIEVE_GLX_SYMBOL(glXSwapBuffers);
+    RETRIEVE_GLX_SYMBOL(glXGetCurrentDrawable);
+
+    RETRIEVE_GLX_SYMBOL(glXCreatePbuffer);
+    RETRIEVE_GLX_SYMBOL(glXDestroyPbuffer);
+    RETRIEVE_GLX_SYMBOL(glXQueryDrawable);
 #undef RETRIEVE_GLX_SYMBOL
 
     self->linux = linux_platform_create();
@@ -119,6 +125,8 @@ glx_platform_create(void)
         goto error;
 
     self->glXCreateContextAttribsARB = (PFNGLXCREATECONTEXTATTRIBSARBPROC) self->glXGetProcAddress((const uint8_t*) "glXCreateContextAttribsARB");
+    self->glXSwapIntervalEXT = self->glXGetProcAddress((const uint8_t*) "glXSwapIntervalEXT");
+    self->glXSwapIntervalMESA = self->glXGetProcAddress((const uint8_t*) "glXSwapIntervalMESA");
 
     self->wcore.vtbl = &glx_platform_vtbl;
     return &self->wcore;
@@ -136,7 +144,7 @@ glx_platform_make_current(struct wcore_platform *wc_self,
 {
     struct glx_platform *self = glx_platform(wc_self);
     Display *dpy = glx_display(wc_dpy)->x11.xlib;
-    GLXDrawable win = wc_window ? glx_window(wc_window)->x11.xcb : 0;
+    GLXDrawable win = wc_window ? glx_window_drawable(glx_window(wc_window)) : 0;
     GLXContext ctx = wc_ctx ? glx_context(wc_ctx)->glx : NULL;
     bool ok;
 
@@ -174,6 +182,23 @@ glx_platform_dl_sym(struct wcore_platform *wc_self,
                                               name);
 }
 
+static int32_t
+glx_platform_dl_sym_many(struct wcore_platform *wc_self,
+                         int32_t waffle_dl,
+                         int32_t count,
+                         const char *const *names,
+                         void **syms)
+{
+    return linux_platform_dl_sym_many(glx_platform(wc_self)->linux,
+                                      waffle_dl, count, names, syms);
+}
+
+static void
+glx_platform_dl_rescan(struct wcore_platform *wc_self)
+{
+    linux_platform_dl_rescan(glx_platform(wc_self)->linux);
+}
+
 static const struct wcore_platform_vtbl glx_platform_vtbl = {
     .destroy = glx_platform_destroy,
 
@@ -181,6 +206,8 @@ static const struct wcore_platform_vtbl glx_platform_vtbl = {
     .get_proc_address = glx_platform_get_proc_address,
     .dl_can_open = glx_platform_dl_can_open,
     .dl_sym = glx_platform_dl_sym,
+    .dl_sym_many = glx_platform_dl_sym_many,
+    .dl_rescan = glx_platform_dl_rescan,
 
     .display = {
         .connect = glx_display_connect,
@@ -203,10 +230,21 @@ static const struct wcore_platform_vtbl glx_platform_vtbl = {
 
     .window = {
         .create = glx_window_create,
+        .create_offscreen = glx_window_create_offscreen,
         .destroy = glx_window_destroy,
         .show = glx_window_show,
         .resize = glx_window_resize,
         .swap_buffers = glx_window_swap_buffers,
+        .get_frame_timing = glx_window_get_frame_timing,
+        .query_buffer_age = glx_window_query_buffer_age,
+        .set_swap_interval = glx_window_set_swap_interval,
         .get_native = glx_window_get_native,
     },
+
+    .fence = {
+        .create = wcore_gl_fence_create,
+        .destroy = wcore_gl_fence_destroy,
+        .client_wait = wcore_gl_fence_client_wait,
+        .server_wait = wcore_gl_fence_server_wait,
+    },
 };
@@ -56,9 +56,19 @@ struct glx_platform {
                                       const int *attribList, int *nitems);
 
     void (*glXSwapBuffers)(Display *dpy, GLXDrawable drawable);
+    GLXDrawable (*glXGetCurrentDrawable)(void);
+
+    GLXPbuffer (*glXCreatePbuffer)(Display *dpy, GLXFBConfig config,
+                                   const int *attribList);
+    void (*glXDestroyPbuffer)(Display *dpy, GLXPbuffer pbuf);
+    void (*glXQueryDrawable)(Display *dpy, GLXDrawable draw,
+                             int attribute, unsigned int *value);
 
 
     PFNGLXCREATECONTEXTATTRIBSARBPROC glXCreateContextAttribsARB;
+    void (*glXSwapIntervalEXT)(Display *dpy, GLXDrawable drawable,
+                               int interval);
+    int (*glXSwapIntervalMESA)(unsigned int interval);
 };
 
 DEFINE_CONTAINER_CAST_FUNC(glx_platform,
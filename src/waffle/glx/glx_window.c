@@ -35,6 +35,10 @@
 #include "glx_window.h"
 #include "glx_wrappers.h"
 
+#ifndef GLX_BACK_BUFFER_AGE_EXT
+#define GLX_BACK_BUFFER_AGE_EXT 0x20F4
+#endif
+
 bool
 glx_window_destroy(struct wcore_window *wc_self)
 {
@@ -44,6 +48,13 @@ glx_window_destroy(struct wcore_window *wc_self)
     if (!wc_self)
         return ok;
 
+    if (self->glx_pbuffer) {
+        struct glx_display *dpy = glx_display(wc_self->display);
+        struct glx_platform *plat = glx_platform(wc_self->display->platform);
+
+        wrapped_glXDestroyPbuffer(plat, dpy->x11.xlib, self->glx_pbuffer);
+    }
+
     ok &= x11_window_teardown(&self->x11);
     ok &= wcore_window_teardown(wc_self);
     free(self);
@@ -95,17 +106,94 @@ error:
     return NULL;
 }
 
+struct wcore_window*
+glx_window_create_offscreen(struct wcore_platform *wc_plat,
+                            struct wcore_config *wc_config,
+                            int32_t width,
+                            int32_t height,
+                            const intptr_t attrib_list[])
+{
+    struct glx_window *self;
+    struct glx_platform *plat = glx_platform(wc_plat);
+    struct glx_display *dpy = glx_display(wc_config->display);
+    struct glx_config *config = glx_config(wc_config);
+    int drawable_type = 0;
+    bool ok = true;
+
+    if (wcore_attrib_list_length(attrib_list) > 0) {
+        wcore_error_bad_attribute(attrib_list[0]);
+        return NULL;
+    }
+
+    if (wrapped_glXGetFBConfigAttrib(plat, dpy->x11.xlib,
+                                     config->glx_fbconfig,
+                                     GLX_DRAWABLE_TYPE,
+                                     &drawable_type)) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "glXGetFBConfigAttrib(GLX_DRAWABLE_TYPE) failed");
+        return NULL;
+    }
+
+    if (!(drawable_type & GLX_PBUFFER_BIT)) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "GLXFBConfig does not support pbuffers");
+        return NULL;
+    }
+
+    self = wcore_calloc(sizeof(*self));
+    if (self == NULL)
+        return NULL;
+
+    ok = wcore_window_init(&self->wcore, wc_config);
+    if (!ok)
+        goto error;
+
+    const int pbuffer_attrib_list[] = {
+        GLX_PBUFFER_WIDTH,  width,
+        GLX_PBUFFER_HEIGHT, height,
+        None,
+    };
+
+    self->glx_pbuffer = wrapped_glXCreatePbuffer(plat, dpy->x11.xlib,
+                                                 config->glx_fbconfig,
+                                                 pbuffer_attrib_list);
+    if (!self->glx_pbuffer) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "glXCreatePbuffer failed");
+        goto error;
+    }
+
+    return &self->wcore;
+
+error:
+    glx_window_destroy(&self->wcore);
+    return NULL;
+}
+
 bool
 glx_window_show(struct wcore_window *wc_self)
 {
-    return x11_window_show(&glx_window(wc_self)->x11);
+    struct glx_window *self = glx_window(wc_self);
+
+    // Offscreen windows are never shown.
+    if (self->glx_pbuffer)
+        return true;
+
+    return x11_window_show(&self->x11);
 }
 
 bool
 glx_window_resize(struct wcore_window *wc_self,
                   int32_t width, int32_t height)
 {
-    return x11_window_resize(&glx_window(wc_self)->x11, width, height);
+    struct glx_window *self = glx_window(wc_self);
+
+    if (self->glx_pbuffer) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "offscreen windows cannot be resized");
+        return false;
+    }
+
+    return x11_window_resize(&self->x11, width, height);
 }
 
 bool
@@ -114,12 +202,111 @@ glx_window_swap_buffers(struct wcore_window *wc_self)
     struct glx_window *self = glx_window(wc_self);
     struct glx_display *dpy = glx_display(wc_self->display);
     struct glx_platform *plat = glx_platform(wc_self->display->platform);
+    uint64_t submit_ns = x11_window_get_time_ns();
+
+    wrapped_glXSwapBuffers(plat, dpy->x11.xlib, glx_window_drawable(self));
 
-    wrapped_glXSwapBuffers(plat, dpy->x11.xlib, self->x11.xcb);
+    if (self->x11.xcb)
+        x11_window_frame_submitted(&self->x11, submit_ns);
 
     return true;
 }
 
+bool
+glx_window_get_frame_timing(struct wcore_window *wc_self,
+                            struct waffle_frame_timing *timing)
+{
+    struct glx_window *self = glx_window(wc_self);
+
+    if (!self->x11.xcb) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "offscreen windows are never presented");
+        return false;
+    }
+
+    return x11_window_get_frame_timing(&self->x11, timing);
+}
+
+bool
+glx_window_query_buffer_age(struct wcore_window *wc_self, int32_t *age)
+{
+    struct glx_window *self = glx_window(wc_self);
+    struct glx_display *dpy = glx_display(wc_self->display);
+    struct glx_platform *plat = glx_platform(wc_self->display->platform);
+    unsigned int value = 0;
+
+    if (!dpy->EXT_buffer_age) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "GLX_EXT_buffer_age is not supported");
+        return false;
+    }
+
+    // GLX_EXT_buffer_age raises GLXBadDrawable unless the drawable is
+    // current, and the wrapper swallows X errors, so check beforehand.
+    if (plat->glXGetCurrentDrawable() != glx_window_drawable(self)) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "window is not current on this thread");
+        return false;
+    }
+
+    wrapped_glXQueryDrawable(plat, dpy->x11.xlib, glx_window_drawable(self),
+                             GLX_BACK_BUFFER_AGE_EXT, &value);
+    *age = value;
+    return true;
+}
+
+bool
+glx_window_set_swap_interval(struct wcore_window *wc_self,
+                             int32_t interval)
+{
+    struct glx_window *self = glx_window(wc_self);
+    struct glx_display *dpy = glx_display(wc_self->display);
+    struct glx_platform *plat = glx_platform(wc_self->display->platform);
+    GLXDrawable drawable = glx_window_drawable(self);
+
+    if (interval < 0 && !dpy->EXT_swap_control_tear) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "GLX_EXT_swap_control_tear is required for negative "
+                     "swap intervals");
+        return false;
+    }
+
+    // glXSwapIntervalMESA acts on the current drawable. Require the window
+    // to be current for the EXT variant too, as EGL and WGL do.
+    if (plat->glXGetCurrentDrawable() != drawable) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "window is not current on this thread");
+        return false;
+    }
+
+    if (dpy->EXT_swap_control && plat->glXSwapIntervalEXT) {
+        wrapped_glXSwapIntervalEXT(plat, dpy->x11.xlib, drawable, interval);
+        return true;
+    }
+
+    if (dpy->MESA_swap_control && plat->glXSwapIntervalMESA) {
+        // Adaptive vsync belongs to the EXT extension; glXSwapIntervalMESA
+        // takes an unsigned interval.
+        if (interval < 0) {
+            wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                         "GLX_MESA_swap_control does not support negative "
+                         "swap intervals");
+            return false;
+        }
+
+        if (plat->glXSwapIntervalMESA(interval) != 0) {
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN, "glXSwapIntervalMESA failed");
+            return false;
+        }
+        return true;
+    }
+
+    wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                 "neither GLX_EXT_swap_control nor GLX_MESA_swap_control "
+                 "is supported");
+    return false;
+}
+
 union waffle_native_window*
 glx_window_get_native(struct wcore_window *wc_self)
 {
@@ -132,7 +319,8 @@ glx_window_get_native(struct wcore_window *wc_self)
         return NULL;
 
     n_window->glx->xlib_display = dpy->x11.xlib;
-    n_window->glx->xlib_window = self->x11.xcb;
+    n_window->glx->xlib_window = self->glx_pbuffer ? None : self->x11.xcb;
+    n_window->glx->glx_pbuffer = self->glx_pbuffer;
 
     return n_window;
 }
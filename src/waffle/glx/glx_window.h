@@ -30,6 +30,9 @@
 #include "wcore_window.h"
 #include "wcore_util.h"
 
+#include <GL/glx.h>
+#undef linux
+
 #include "x11_window.h"
 
 struct wcore_platform;
@@ -37,12 +40,22 @@ struct wcore_platform;
 struct glx_window {
     struct wcore_window wcore;
     struct x11_window x11;
+
+    /// Non-zero only for offscreen windows, in which case x11.xcb is 0.
+    GLXPbuffer glx_pbuffer;
 };
 
 DEFINE_CONTAINER_CAST_FUNC(glx_window,
                            struct glx_window,
                            struct wcore_window,
                            wcore)
+
+static inline GLXDrawable
+glx_window_drawable(struct glx_window *self)
+{
+    return self->glx_pbuffer ? self->glx_pbuffer : self->x11.xcb;
+}
+
 struct wcore_window*
 glx_window_create(struct wcore_platform *wc_plat,
                   struct wcore_config *wc_config,
@@ -50,6 +63,13 @@ glx_window_create(struct wcore_platform *wc_plat,
                   int32_t height,
                   const intptr_t attrib_list[]);
 
+struct wcore_window*
+glx_window_create_offscreen(struct wcore_platform *wc_plat,
+                            struct wcore_config *wc_config,
+                            int32_t width,
+                            int32_t height,
+                            const intptr_t attrib_list[]);
+
 bool
 glx_window_destroy(struct wcore_window *wc_self);
 
@@ -63,5 +83,16 @@ glx_window_resize(struct wcore_window *wc_self,
 bool
 glx_window_swap_buffers(struct wcore_window *wc_self);
 
+bool
+glx_window_get_frame_timing(struct wcore_window *wc_self,
+                            struct waffle_frame_timing *timing);
+
+bool
+glx_window_query_buffer_age(struct wcore_window *wc_self, int32_t *age);
+
+bool
+glx_window_set_swap_interval(struct wcore_window *wc_self,
+                             int32_t interval);
+
 union waffle_native_window*
 glx_window_get_native(struct wcore_window *wc_self);
@@ -131,6 +131,26 @@ wrapped_glXQueryExtensionsString(struct glx_platform *platform,
     return s;
 }
 
+static inline GLXPbuffer
+wrapped_glXCreatePbuffer(struct glx_platform *platform,
+                         Display *dpy, GLXFBConfig config,
+                         const int *attribList)
+{
+    X11_SAVE_ERROR_HANDLER
+    GLXPbuffer pbuf = platform->glXCreatePbuffer(dpy, config, attribList);
+    X11_RESTORE_ERROR_HANDLER
+    return pbuf;
+}
+
+static inline void
+wrapped_glXDestroyPbuffer(struct glx_platform *platform,
+                          Display *dpy, GLXPbuffer pbuf)
+{
+    X11_SAVE_ERROR_HANDLER
+    platform->glXDestroyPbuffer(dpy, pbuf);
+    X11_RESTORE_ERROR_HANDLER
+}
+
 static inline void
 wrapped_glXSwapBuffers(struct glx_platform *platform,
                        Display *dpy, GLXDrawable drawable)
@@ -139,3 +159,22 @@ wrapped_glXSwapBuffers(struct glx_platform *platform,
     platform->glXSwapBuffers(dpy, drawable);
     X11_RESTORE_ERROR_HANDLER
 }
+
+static inline void
+wrapped_glXQueryDrawable(struct glx_platform *platform,
+                         Display *dpy, GLXDrawable draw,
+                         int attribute, unsigned int *value)
+{
+    X11_SAVE_ERROR_HANDLER
+    platform->glXQueryDrawable(dpy, draw, attribute, value);
+    X11_RESTORE_ERROR_HANDLER
+}
+
+static inline void
+wrapped_glXSwapIntervalEXT(struct glx_platform *platform,
+                           Display *dpy, GLXDrawable drawable, int interval)
+{
+    X11_SAVE_ERROR_HANDLER
+    platform->glXSwapIntervalEXT(dpy, drawable, interval);
+    X11_RESTORE_ERROR_HANDLER
+}
@@ -43,7 +43,7 @@ struct linux_dl {
     void *dl;
 };
 
-static const char*
+const char*
 linux_dl_get_name(int32_t waffle_dl)
 {
     switch (waffle_dl) {
@@ -138,3 +138,25 @@ linux_dl_sym(struct linux_dl *self, const char *symbol)
 
     return sym;
 }
+
+int32_t
+linux_dl_sym_many(struct linux_dl *self,
+                  int32_t count,
+                  const char *const *symbols,
+                  void **syms)
+{
+    int32_t found = 0;
+
+    for (int32_t i = 0; i < count; ++i) {
+        if (!syms[i] && symbols[i])
+            syms[i] = dlsym(self->dl, symbols[i]);
+        if (syms[i])
+            found++;
+    }
+
+    // Drop the message of any failed lookup, so that it does not leak into
+    // the next linux_dl_sym().
+    dlerror();
+
+    return found;
+}
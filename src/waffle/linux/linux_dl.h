@@ -33,6 +33,11 @@
 
 struct linux_dl;
 
+/// @brief Get the file name of the library, such as "libGLESv2.so.2".
+/// @a waffle_dl must be one of `WAFFLE_DL_*`.
+const char*
+linux_dl_get_name(int32_t waffle_dl);
+
 /// @brief Dynamically open an OpenGL library.
 /// @a waffle_dl must be one of `WAFFLE_DL_*`.
 struct linux_dl*
@@ -43,3 +48,13 @@ linux_dl_close(struct linux_dl *self);
 
 void*
 linux_dl_sym(struct linux_dl *self, const char *symbol);
+
+/// @brief Look up `symbols[i]` for each `syms[i]` that is null.
+///
+/// Unlike linux_dl_sym(), emit no error for symbols that are not found; their
+/// `syms[i]` stay null. Return the number of non-null entries in @a syms.
+int32_t
+linux_dl_sym_many(struct linux_dl *self,
+                  int32_t count,
+                  const char *const *symbols,
+                  void **syms);
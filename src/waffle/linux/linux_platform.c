@@ -25,22 +25,46 @@
 
 #include <stdlib.h>
 
+#include "threads.h"
+
 #include "wcore_error.h"
 #include "wcore_util.h"
 
 #include "linux_dl.h"
 #include "linux_platform.h"
 
+/// @brief A library that is opened on first use.
+struct linux_platform_lib {
+    struct linux_dl *dl;
+
+    /// @brief Set if dlopen() failed.
+    ///
+    /// Later lookups fail immediately rather than search the library path
+    /// again, until linux_platform_dl_rescan().
+    bool failed;
+};
+
 struct linux_platform {
-    struct linux_dl *libgl;
-    struct linux_dl *libgles1;
-    struct linux_dl *libgles2;
+    /// @brief Serializes dlopen() of the libraries.
+    ///
+    /// Each `dl` and `failed` below is published with release semantics, and
+    /// from then on is read with acquire semantics and no lock.
+    mtx_t mutex;
+
+    struct linux_platform_lib libgl;
+    struct linux_platform_lib libgles1;
+    struct linux_platform_lib libgles2;
 };
 
 struct linux_platform*
 linux_platform_create(void)
 {
-    return wcore_calloc(sizeof(struct linux_platform));
+    struct linux_platform *self = wcore_calloc(sizeof(*self));
+    if (!self)
+        return NULL;
+
+    mtx_init(&self->mutex, mtx_plain);
+    return self;
 }
 
 bool
@@ -52,35 +76,65 @@ linux_platform_destroy(struct linux_platform *self)
         return true;
 
     // FIXME: Waffle is unable to emit a sequence of errors.
-    ok &= linux_dl_close(self->libgl);
-    ok &= linux_dl_close(self->libgles1);
-    ok &= linux_dl_close(self->libgles2);
+    ok &= linux_dl_close(self->libgl.dl);
+    ok &= linux_dl_close(self->libgles1.dl);
+    ok &= linux_dl_close(self->libgles2.dl);
 
+    mtx_destroy(&self->mutex);
     free(self);
     return ok;
 }
 
-static struct linux_dl*
+struct linux_dl*
 linux_platform_get_dl(
         struct linux_platform *self,
         int32_t waffle_dl)
 {
-    struct linux_dl **dl;
+    struct linux_platform_lib *lib;
+    struct linux_dl *dl;
+    bool failed;
 
     switch (waffle_dl) {
-        case WAFFLE_DL_OPENGL:     dl = &self->libgl;    break;
-        case WAFFLE_DL_OPENGL_ES1: dl = &self->libgles1; break;
-        case WAFFLE_DL_OPENGL_ES2: dl = &self->libgles2; break;
-        case WAFFLE_DL_OPENGL_ES3: dl = &self->libgles2; break;
+        case WAFFLE_DL_OPENGL:     lib = &self->libgl;    break;
+        case WAFFLE_DL_OPENGL_ES1: lib = &self->libgles1; break;
+        case WAFFLE_DL_OPENGL_ES2: lib = &self->libgles2; break;
+        case WAFFLE_DL_OPENGL_ES3: lib = &self->libgles2; break;
         default:
             wcore_error_internal("waffle_dl has bad value %#x", waffle_dl);
             return NULL;
     }
 
-    if (*dl == NULL)
-        *dl = linux_dl_open(waffle_dl);
+    // Fast path: an earlier call opened the library, or failed to.
+    dl = __atomic_load_n(&lib->dl, __ATOMIC_ACQUIRE);
+    if (dl)
+        return dl;
+
+    if (__atomic_load_n(&lib->failed, __ATOMIC_ACQUIRE))
+        goto failed;
+
+    // Slow path: try to open the library at most once, even if several
+    // threads race here.
+    mtx_lock(&self->mutex);
+    dl = __atomic_load_n(&lib->dl, __ATOMIC_RELAXED);
+    failed = __atomic_load_n(&lib->failed, __ATOMIC_RELAXED);
+    if (!dl && !failed) {
+        // On failure, linux_dl_open() emits the error of dlopen().
+        dl = linux_dl_open(waffle_dl);
+        if (dl)
+            __atomic_store_n(&lib->dl, dl, __ATOMIC_RELEASE);
+        else
+            __atomic_store_n(&lib->failed, true, __ATOMIC_RELEASE);
+    }
+    mtx_unlock(&self->mutex);
 
-    return *dl;
+    if (!failed)
+        return dl;
+
+failed:
+    wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                 "dlopen(\"%s\") failed earlier; waffle_dl_rescan() "
+                 "retries it", linux_dl_get_name(waffle_dl));
+    return NULL;
 }
 
 bool
@@ -107,3 +161,28 @@ linux_platform_dl_sym(
 
     return linux_dl_sym(dl, name);
 }
+
+int32_t
+linux_platform_dl_sym_many(
+        struct linux_platform *self,
+        int32_t waffle_dl,
+        int32_t count,
+        const char *const *names,
+        void **syms)
+{
+    struct linux_dl *dl = linux_platform_get_dl(self, waffle_dl);
+    if (!dl)
+        return -1;
+
+    return linux_dl_sym_many(dl, count, names, syms);
+}
+
+void
+linux_platform_dl_rescan(struct linux_platform *self)
+{
+    mtx_lock(&self->mutex);
+    __atomic_store_n(&self->libgl.failed, false, __ATOMIC_RELEASE);
+    __atomic_store_n(&self->libgles1.failed, false, __ATOMIC_RELEASE);
+    __atomic_store_n(&self->libgles2.failed, false, __ATOMIC_RELEASE);
+    mtx_unlock(&self->mutex);
+}
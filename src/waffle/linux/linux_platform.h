@@ -28,6 +28,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+struct linux_dl;
 struct linux_platform;
 
 struct linux_platform*
@@ -36,6 +37,16 @@ linux_platform_create(void);
 bool
 linux_platform_destroy(struct linux_platform *self);
 
+/// @brief Get the library, opening it on first use.
+///
+/// Every call returns the same `struct linux_dl`, even when threads race on
+/// the first call, until linux_platform_destroy(). Return null and emit an
+/// error if the library cannot be opened.
+struct linux_dl*
+linux_platform_get_dl(
+        struct linux_platform *self,
+        int32_t waffle_dl);
+
 /// @copydoc waffle_dl_can_open()
 bool
 linux_platform_dl_can_open(
@@ -47,3 +58,17 @@ linux_platform_dl_sym(
         struct linux_platform *self,
         int32_t waffle_dl,
         const char *name);
+
+/// Return the number of symbols found, or -1 if the library cannot be
+/// opened. See linux_dl_sym_many().
+int32_t
+linux_platform_dl_sym_many(
+        struct linux_platform *self,
+        int32_t waffle_dl,
+        int32_t count,
+        const char *const *names,
+        void **syms);
+
+/// @brief Forget which libraries failed to open, so that they are retried.
+void
+linux_platform_dl_rescan(struct linux_platform *self);
@@ -0,0 +1,228 @@
+// Copyright 2016 Google
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "c99_compat.h"
+#include "threads.h"
+
+#include <cmocka.h>
+
+#include "waffle.h"
+
+#include "wcore_error.h"
+
+#include "linux_dl.h"
+#include "linux_platform.h"
+
+/// Number of threads and rounds in test linux_platform.concurrent_get_dl.
+enum {
+    NUM_THREADS = 8,
+    NUM_ROUNDS = 50,
+};
+
+static const int32_t dls[] = {
+    WAFFLE_DL_OPENGL,
+    WAFFLE_DL_OPENGL_ES1,
+    WAFFLE_DL_OPENGL_ES2,
+    WAFFLE_DL_OPENGL_ES3,
+};
+
+#define NUM_DLS ((int) (sizeof(dls) / sizeof(dls[0])))
+
+/// Shared by all threads of one round.
+struct round {
+    struct linux_platform *platform;
+
+    /// Protects `go`.
+    mtx_t mutex;
+
+    /// Signaled when `go` becomes true.
+    cnd_t cond;
+
+    bool go;
+};
+
+/// Given to thrd_create() in test linux_platform.concurrent_get_dl.
+struct thread_arg {
+    struct round *round;
+
+    bool can_open[NUM_DLS];
+    struct linux_dl *dl[NUM_DLS];
+};
+
+static int
+thread_start(void *arg)
+{
+    struct thread_arg *a = arg;
+    struct round *r = a->round;
+
+    // Wait for all threads to be created, so that they race on the first
+    // dlopen of each library.
+    mtx_lock(&r->mutex);
+    while (!r->go)
+        cnd_wait(&r->cond, &r->mutex);
+    mtx_unlock(&r->mutex);
+
+    for (int i = 0; i < NUM_DLS; ++i) {
+        a->can_open[i] = linux_platform_dl_can_open(r->platform, dls[i]);
+        a->dl[i] = linux_platform_get_dl(r->platform, dls[i]);
+    }
+
+    return 0;
+}
+
+// Test that threads racing on the lazy dlopen of each library agree on the
+// result. Comparing symbol addresses would not catch a double open, because
+// dlopen() is refcounted; two opens would give two distinct linux_dl.
+static void
+test_linux_platform_concurrent_get_dl(void **state) {
+    for (int n = 0; n < NUM_ROUNDS; ++n) {
+        struct round r = { .go = false };
+        thrd_t threads[NUM_THREADS];
+        struct thread_arg args[NUM_THREADS] = {{0}};
+
+        r.platform = linux_platform_create();
+        assert_true(r.platform != NULL);
+        mtx_init(&r.mutex, mtx_plain);
+        cnd_init(&r.cond);
+
+        for (int i = 0; i < NUM_THREADS; ++i) {
+            args[i].round = &r;
+            assert_int_equal(thrd_create(&threads[i], thread_start, &args[i]),
+                             thrd_success);
+        }
+
+        mtx_lock(&r.mutex);
+        r.go = true;
+        cnd_broadcast(&r.cond);
+        mtx_unlock(&r.mutex);
+
+        for (int i = 0; i < NUM_THREADS; ++i)
+            thrd_join(threads[i], NULL);
+
+        for (int j = 0; j < NUM_DLS; ++j)
+            assert_int_equal(args[0].dl[j] != NULL, args[0].can_open[j]);
+
+        for (int i = 1; i < NUM_THREADS; ++i) {
+            for (int j = 0; j < NUM_DLS; ++j) {
+                assert_int_equal(args[i].can_open[j], args[0].can_open[j]);
+                assert_true(args[i].dl[j] == args[0].dl[j]);
+            }
+        }
+
+        assert_true(linux_platform_destroy(r.platform));
+        cnd_destroy(&r.cond);
+        mtx_destroy(&r.mutex);
+    }
+}
+
+/// The library that __wrap_dlopen() pretends is not installed.
+static const char *missing_lib;
+
+/// Number of calls to dlopen() for `missing_lib`.
+static int missing_lib_opens;
+
+/// Whether the last call to __wrap_dlopen() failed for `missing_lib`.
+static bool missing_lib_failed;
+
+void *__real_dlopen(const char *filename, int flags);
+char *__real_dlerror(void);
+
+void *__wrap_dlopen(const char *filename, int flags);
+char *__wrap_dlerror(void);
+
+// The test is linked with --wrap=dlopen and --wrap=dlerror, so linux_dl.c
+// calls these.
+void*
+__wrap_dlopen(const char *filename, int flags)
+{
+    missing_lib_failed = false;
+
+    if (missing_lib && filename && strcmp(filename, missing_lib) == 0) {
+        ++missing_lib_opens;
+        missing_lib_failed = true;
+        return NULL;
+    }
+
+    return __real_dlopen(filename, flags);
+}
+
+char*
+__wrap_dlerror(void)
+{
+    static char message[] = "not found";
+
+    if (missing_lib_failed) {
+        missing_lib_failed = false;
+        return message;
+    }
+
+    return __real_dlerror();
+}
+
+// Test that a library that failed to open is not searched for again until
+// linux_platform_dl_rescan().
+static void
+test_linux_platform_rescan(void **state) {
+    struct linux_platform *platform = linux_platform_create();
+    assert_true(platform != NULL);
+
+    missing_lib = linux_dl_get_name(WAFFLE_DL_OPENGL_ES1);
+    missing_lib_opens = 0;
+
+    // The second failure comes from the negative cache.
+    assert_false(linux_platform_dl_can_open(platform, WAFFLE_DL_OPENGL_ES1));
+    assert_int_equal(missing_lib_opens, 1);
+    assert_true(linux_platform_dl_sym(platform, WAFFLE_DL_OPENGL_ES1,
+                                      "glClear") == NULL);
+    assert_int_equal(missing_lib_opens, 1);
+    assert_int_equal(wcore_error_get_code(), WAFFLE_ERROR_UNKNOWN);
+    assert_true(strstr(wcore_error_get_info()->message, "failed earlier"));
+
+    // Rescanning clears the failure, so the next lookup opens again.
+    linux_platform_dl_rescan(platform);
+    assert_false(linux_platform_dl_can_open(platform, WAFFLE_DL_OPENGL_ES1));
+    assert_int_equal(missing_lib_opens, 2);
+    assert_false(linux_platform_dl_can_open(platform, WAFFLE_DL_OPENGL_ES1));
+    assert_int_equal(missing_lib_opens, 2);
+
+    assert_true(linux_platform_destroy(platform));
+    missing_lib = NULL;
+}
+
+int
+main(void) {
+    const UnitTest tests[] = {
+        unit_test(test_linux_platform_concurrent_get_dl),
+        unit_test(test_linux_platform_rescan),
+    };
+
+    return run_tests(tests);
+}
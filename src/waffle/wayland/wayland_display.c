@@ -25,12 +25,16 @@
 
 #define WL_EGL_PLATFORM 1
 
+#include <errno.h>
+#include <poll.h>
 #include <stdlib.h>
 #include <string.h>
 
 // The wrapper must be included before wayland-client.h
 #include "wayland_wrapper.h"
 #include <wayland-client.h>
+#include "xdg-shell-client-protocol.h"
+#include "presentation-time-client-protocol.h"
 #undef container_of
 
 #include "wcore_error.h"
@@ -52,6 +56,12 @@ wayland_display_destroy(struct wcore_display *wc_self)
 
     ok &= wegl_display_teardown(&self->wegl);
 
+    if (self->xdg_wm_base)
+        xdg_wm_base_destroy(self->xdg_wm_base);
+
+    if (self->wp_presentation)
+        wp_presentation_destroy(self->wp_presentation);
+
     if (self->wl_display)
         wl_display_disconnect(self->wl_display);
 
@@ -59,6 +69,31 @@ wayland_display_destroy(struct wcore_display *wc_self)
     return ok;
 }
 
+static void
+xdg_wm_base_listener_ping(void *data,
+                          struct xdg_wm_base *xdg_wm_base,
+                          uint32_t serial)
+{
+    xdg_wm_base_pong(xdg_wm_base, serial);
+}
+
+static const struct xdg_wm_base_listener xdg_wm_base_listener = {
+    .ping = xdg_wm_base_listener_ping,
+};
+
+static void
+presentation_listener_clock_id(void *data,
+                               struct wp_presentation *wp_presentation,
+                               uint32_t clk_id)
+{
+    struct wayland_display *self = data;
+    self->presentation_clock = clk_id;
+}
+
+static const struct wp_presentation_listener presentation_listener = {
+    .clock_id = presentation_listener_clock_id,
+};
+
 static void
 registry_listener_global(void *data,
                          struct wl_registry *registry,
@@ -76,6 +111,19 @@ registry_listener_global(void *data,
         self->wl_shell = wl_registry_bind(self->wl_registry, name,
                                           &wl_shell_interface, 1);
     }
+    else if (!strcmp(interface, "xdg_wm_base")) {
+        self->xdg_wm_base = wl_registry_bind(self->wl_registry, name,
+                                             &xdg_wm_base_interface, 1);
+        xdg_wm_base_add_listener(self->xdg_wm_base,
+                                 &xdg_wm_base_listener, NULL);
+    }
+    else if (!strcmp(interface, "wp_presentation")) {
+        self->wp_presentation = wl_registry_bind(self->wl_registry, name,
+                                                 &wp_presentation_interface,
+                                                 1);
+        wp_presentation_add_listener(self->wp_presentation,
+                                     &presentation_listener, self);
+    }
 }
 
 static void
@@ -102,6 +150,8 @@ wayland_display_connect(struct wcore_platform *wc_plat,
     if (self == NULL)
         return NULL;
 
+    self->presentation_clock = CLOCK_MONOTONIC;
+
     self->wl_display = wl_display_connect(name);
     if (!self->wl_display) {
         wcore_errorf(WAFFLE_ERROR_UNKNOWN, "wl_display_connect failed");
@@ -136,7 +186,7 @@ wayland_display_connect(struct wcore_platform *wc_plat,
         goto error;
     }
 
-    if (!self->wl_shell) {
+    if (!self->wl_shell && !self->xdg_wm_base) {
         wcore_errorf(WAFFLE_ERROR_UNKNOWN, "failed to bind to the wayland "
                      "shell");
         goto error;
@@ -160,6 +210,7 @@ wayland_display_fill_native(struct wayland_display *self,
     n_dpy->wl_display = self->wl_display;
     n_dpy->wl_compositor = self->wl_compositor;
     n_dpy->wl_shell = self->wl_shell;
+    n_dpy->xdg_wm_base = self->xdg_wm_base;
     n_dpy->egl_display = self->wegl.egl;
 }
 
@@ -188,3 +239,43 @@ wayland_display_sync(struct wayland_display *dpy)
 
     return true;
 }
+
+bool
+wayland_display_flush(struct wayland_display *dpy)
+{
+    struct pollfd pfd = {
+        .fd = wl_display_get_fd(dpy->wl_display),
+        .events = POLLIN,
+    };
+
+    // Read whatever has arrived, but do not wait for more.
+    while (wl_display_prepare_read(dpy->wl_display) != 0) {
+        if (wl_display_dispatch_pending(dpy->wl_display) == -1) {
+            wcore_error_errno("error on wl_display");
+            return false;
+        }
+    }
+
+    if (poll(&pfd, 1, 0) > 0) {
+        if (wl_display_read_events(dpy->wl_display) == -1) {
+            wcore_error_errno("error on wl_display");
+            return false;
+        }
+    } else {
+        wl_display_cancel_read(dpy->wl_display);
+    }
+
+    if (wl_display_dispatch_pending(dpy->wl_display) == -1) {
+        wcore_error_errno("error on wl_display");
+        return false;
+    }
+
+    // EAGAIN means the socket buffer is full. The remaining requests are
+    // written on the next flush, so it is not an error.
+    if (wl_display_flush(dpy->wl_display) == -1 && errno != EAGAIN) {
+        wcore_error_errno("error on wl_display");
+        return false;
+    }
+
+    return true;
+}
@@ -27,6 +27,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <time.h>
 
 #include "wcore_display.h"
 #include "wcore_util.h"
@@ -39,12 +40,24 @@ struct wcore_platform;
 struct wl_display;
 struct wl_compositor;
 struct wl_shell;
+struct xdg_wm_base;
+struct wp_presentation;
 
 struct wayland_display {
     struct wl_display *wl_display;
     struct wl_registry *wl_registry;
     struct wl_compositor *wl_compositor;
+
+    /// Windows use xdg_wm_base if the compositor provides it, and the
+    /// deprecated wl_shell otherwise. At least one is non-null.
     struct wl_shell *wl_shell;
+    struct xdg_wm_base *xdg_wm_base;
+
+    /// Null if the compositor lacks presentation-time, in which case windows
+    /// have no frame timing.
+    struct wp_presentation *wp_presentation;
+    /// The clock of wp_presentation's timestamps.
+    clockid_t presentation_clock;
 
     struct wegl_display wegl;
 };
@@ -90,3 +103,11 @@ wayland_display_get_native(struct wcore_display *wc_self);
 /// public entry points synchronous.
 bool
 wayland_display_sync(struct wayland_display *dpy);
+
+/// @brief Dispatch pending events and flush requests, without blocking.
+///
+/// This is the non-blocking counterpart of wayland_display_sync(), for use
+/// on paths such as buffer swaps where a roundtrip per call is too costly.
+/// Events that have already arrived on the socket are read and dispatched.
+bool
+wayland_display_flush(struct wayland_display *dpy);
@@ -37,6 +37,8 @@
 
 #include "wegl_config.h"
 #include "wegl_context.h"
+#include "wegl_fence.h"
+#include "wegl_image.h"
 #include "wegl_platform.h"
 #include "wegl_util.h"
 
@@ -90,7 +92,7 @@ wayland_platform_create(void)
     if (self == NULL)
         return NULL;
 
-    ok = wegl_platform_init(&self->wegl);
+    ok = wegl_platform_init(&self->wegl, EGL_PLATFORM_WAYLAND_KHR);
     if (!ok)
         goto error;
 
@@ -152,6 +154,24 @@ wayland_dl_sym(struct wcore_platform *wc_self,
     return linux_platform_dl_sym(self->linux, waffle_dl, name);
 }
 
+static int32_t
+wayland_dl_sym_many(struct wcore_platform *wc_self,
+                    int32_t waffle_dl,
+                    int32_t count,
+                    const char *const *names,
+                    void **syms)
+{
+    struct wayland_platform *self = wayland_platform(wegl_platform(wc_self));
+    return linux_platform_dl_sym_many(self->linux, waffle_dl, count, names, syms);
+}
+
+static void
+wayland_dl_rescan(struct wcore_platform *wc_self)
+{
+    struct wayland_platform *self = wayland_platform(wegl_platform(wc_self));
+    linux_platform_dl_rescan(self->linux);
+}
+
 static union waffle_native_config*
 wayland_config_get_native(struct wcore_config *wc_config)
 {
@@ -193,6 +213,8 @@ static const struct wcore_platform_vtbl wayland_platform_vtbl = {
     .get_proc_address = wegl_get_proc_address,
     .dl_can_open = wayland_dl_can_open,
     .dl_sym = wayland_dl_sym,
+    .dl_sym_many = wayland_dl_sym_many,
+    .dl_rescan = wayland_dl_rescan,
 
     .display = {
         .connect = wayland_display_connect,
@@ -215,10 +237,30 @@ static const struct wcore_platform_vtbl wayland_platform_vtbl = {
 
     .window = {
         .create = wayland_window_create,
+        .create_offscreen = wayland_window_create_offscreen,
         .destroy = wayland_window_destroy,
         .show = wayland_window_show,
         .swap_buffers = wayland_window_swap_buffers,
+        .swap_buffers_with_damage = wayland_window_swap_buffers_with_damage,
+        .get_frame_timing = wayland_window_get_frame_timing,
         .resize = wayland_window_resize,
+        .query_buffer_age = wegl_window_query_buffer_age,
+        .set_damage_region = wegl_window_set_damage_region,
+        .set_swap_interval = wayland_window_set_swap_interval,
         .get_native = wayland_window_get_native,
     },
+
+    .fence = {
+        .create = wegl_fence_create,
+        .destroy = wegl_fence_destroy,
+        .client_wait = wegl_fence_client_wait,
+        .server_wait = wegl_fence_server_wait,
+    },
+
+    .image = {
+        .create_from_texture = wegl_image_create_from_texture,
+        .create_from_renderbuffer = wegl_image_create_from_renderbuffer,
+        .destroy = wegl_image_destroy,
+        .bind_texture = wegl_image_bind_texture,
+    },
 };
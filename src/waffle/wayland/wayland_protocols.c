@@ -0,0 +1,52 @@
+// Copyright 2016 Google
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/// @file
+/// @brief Protocol code for xdg-shell and presentation-time, generated by
+/// wayland-scanner.
+///
+/// The generated code refers to wl_output_interface, wl_seat_interface and
+/// wl_surface_interface, which live in libwayland-client. Waffle dlopens that
+/// library, so those symbols cannot be linked against. Defining them here
+/// under their own names would also be wrong, as they would shadow the real
+/// ones for applications that link waffle statically.
+///
+/// Instead, the references are renamed to local stand-ins. libwayland-client
+/// only uses the interfaces of object arguments to type-check incoming events,
+/// which it does by comparing interface names. So the stand-ins need nothing
+/// but the correct name.
+
+#include "wayland-util.h"
+
+#define wl_output_interface wfl_xdg_wl_output_interface
+#define wl_seat_interface wfl_xdg_wl_seat_interface
+#define wl_surface_interface wfl_xdg_wl_surface_interface
+
+const struct wl_interface wl_output_interface = { .name = "wl_output" };
+const struct wl_interface wl_seat_interface = { .name = "wl_seat" };
+const struct wl_interface wl_surface_interface = { .name = "wl_surface" };
+
+#include "xdg-shell-protocol.c"
+#include "presentation-time-protocol.c"
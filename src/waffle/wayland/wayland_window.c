@@ -27,10 +27,13 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 // The wrapper must be included before wayland-(client|egl).h
 #include "wayland_wrapper.h"
 #include <wayland-egl.h>
+#include "xdg-shell-client-protocol.h"
+#include "presentation-time-client-protocol.h"
 #undef container_of
 
 #include "waffle_wayland.h"
@@ -44,22 +47,37 @@
 #include "wayland_platform.h"
 #include "wayland_window.h"
 
-bool
-wayland_window_destroy(struct wcore_window *wc_self)
+/// Free @a self, which may be partially initialized by wayland_window_create()
+/// or wayland_window_create_offscreen().
+static bool
+wayland_window_teardown(struct wayland_window *self,
+                        struct wayland_platform *plat)
 {
-    struct wcore_platform *wc_plat = wc_self->display->platform;
-    struct wayland_platform *plat = wayland_platform(wegl_platform(wc_plat));
-    struct wayland_window *self = wayland_window(wc_self);
     bool ok = true;
 
-    if (!self)
-        return ok;
+    // wegl_window_init() and wegl_pbuffer_init() clean up after themselves
+    // when they fail, so there is something to tear down only once the EGL
+    // surface exists.
+    if (self->wegl.egl)
+        ok &= wegl_window_teardown(&self->wegl);
 
-    ok &= wegl_window_teardown(&self->wegl);
+    if (self->frame_callback)
+        wl_callback_destroy(self->frame_callback);
+
+    for (int i = 0; i < WAYLAND_WINDOW_MAX_FEEDBACKS; i++) {
+        if (self->feedbacks[i].feedback)
+            wp_presentation_feedback_destroy(self->feedbacks[i].feedback);
+    }
 
     if (self->wl_window)
         plat->wl_egl_window_destroy(self->wl_window);
 
+    if (self->xdg_toplevel)
+        xdg_toplevel_destroy(self->xdg_toplevel);
+
+    if (self->xdg_surface)
+        xdg_surface_destroy(self->xdg_surface);
+
     if (self->wl_shell_surface)
         wl_shell_surface_destroy(self->wl_shell_surface);
 
@@ -70,6 +88,19 @@ wayland_window_destroy(struct wcore_window *wc_self)
     return ok;
 }
 
+bool
+wayland_window_destroy(struct wcore_window *wc_self)
+{
+    struct wayland_window *self = wayland_window(wc_self);
+
+    if (!self)
+        return true;
+
+    struct wcore_platform *wc_plat = wc_self->display->platform;
+    return wayland_window_teardown(self,
+                                   wayland_platform(wegl_platform(wc_plat)));
+}
+
 static void
 shell_surface_listener_ping(void *data,
                             struct wl_shell_surface *shell_surface,
@@ -99,6 +130,101 @@ static const struct wl_shell_surface_listener shell_surface_listener = {
     .popup_done = shell_surface_listener_popup_done
 };
 
+static bool
+wayland_window_init_wl_shell(struct wayland_window *self,
+                             struct wayland_display *dpy)
+{
+    self->wl_shell_surface = wl_shell_get_shell_surface(dpy->wl_shell,
+                                                        self->wl_surface);
+    if (!self->wl_shell_surface) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "wl_shell_get_shell_surface failed");
+        return false;
+    }
+
+    wl_shell_surface_add_listener(self->wl_shell_surface,
+                                  &shell_surface_listener,
+                                  NULL);
+    return true;
+}
+
+static void
+xdg_surface_listener_configure(void *data,
+                               struct xdg_surface *xdg_surface,
+                               uint32_t serial)
+{
+    struct wayland_window *self = data;
+
+    xdg_surface_ack_configure(xdg_surface, serial);
+    self->xdg_configured = true;
+}
+
+static const struct xdg_surface_listener xdg_surface_listener = {
+    .configure = xdg_surface_listener_configure,
+};
+
+static void
+xdg_toplevel_listener_configure(void *data,
+                                struct xdg_toplevel *xdg_toplevel,
+                                int32_t width,
+                                int32_t height,
+                                struct wl_array *states)
+{
+    // The suggested size is advisory unless the window is maximized or
+    // fullscreen, which waffle never requests. Keep the size the user asked
+    // for.
+}
+
+static void
+xdg_toplevel_listener_close(void *data,
+                            struct xdg_toplevel *xdg_toplevel)
+{
+}
+
+static const struct xdg_toplevel_listener xdg_toplevel_listener = {
+    .configure = xdg_toplevel_listener_configure,
+    .close = xdg_toplevel_listener_close,
+};
+
+static bool
+wayland_window_init_xdg_shell(struct wayland_window *self,
+                              struct wayland_display *dpy)
+{
+    self->xdg_surface = xdg_wm_base_get_xdg_surface(dpy->xdg_wm_base,
+                                                    self->wl_surface);
+    if (!self->xdg_surface) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "xdg_wm_base_get_xdg_surface failed");
+        return false;
+    }
+
+    xdg_surface_add_listener(self->xdg_surface, &xdg_surface_listener, self);
+
+    self->xdg_toplevel = xdg_surface_get_toplevel(self->xdg_surface);
+    if (!self->xdg_toplevel) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "xdg_surface_get_toplevel failed");
+        return false;
+    }
+
+    xdg_toplevel_add_listener(self->xdg_toplevel,
+                              &xdg_toplevel_listener, self);
+
+    // Commit the role without a buffer, then wait for the initial configure.
+    // Until it is acked, the surface must not be given a buffer, and anything
+    // rendered would be thrown away.
+    wl_surface_commit(self->wl_surface);
+
+    while (!self->xdg_configured) {
+        if (wl_display_dispatch(dpy->wl_display) == -1) {
+            wcore_error_errno("error on wl_display");
+            return false;
+        }
+    }
+
+    return true;
+}
+
 struct wcore_window*
 wayland_window_create(struct wcore_platform *wc_plat,
                       struct wcore_config *wc_config,
@@ -109,6 +235,8 @@ wayland_window_create(struct wcore_platform *wc_plat,
     struct wayland_window *self;
     struct wayland_platform *plat = wayland_platform(wegl_platform(wc_plat));
     struct wayland_display *dpy = wayland_display(wc_config->display);
+    intptr_t *attrib_list_filtered;
+    intptr_t sync_swap = 0;
     bool ok = true;
 
     if (width == -1 && height == -1) {
@@ -117,20 +245,41 @@ wayland_window_create(struct wcore_platform *wc_plat,
         return NULL;
     }
 
-    if (wcore_attrib_list_length(attrib_list) > 0) {
-        wcore_error_bad_attribute(attrib_list[0]);
+    attrib_list_filtered = wcore_attrib_list_copy(attrib_list);
+    wcore_attrib_list_pop(attrib_list_filtered,
+                          WAFFLE_WINDOW_WAYLAND_SYNC_SWAP, &sync_swap);
+    if (sync_swap == WAFFLE_DONT_CARE)
+        sync_swap = 0; // default
+
+    if (sync_swap != 0 && sync_swap != 1) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "WAFFLE_WINDOW_WAYLAND_SYNC_SWAP has bad value 0x%x. "
+                     "Must be true(1), false(0), or WAFFLE_DONT_CARE(-1)",
+                     (int) sync_swap);
+        free(attrib_list_filtered);
         return NULL;
     }
 
+    if (wcore_attrib_list_length(attrib_list_filtered) > 0) {
+        wcore_error_bad_attribute(attrib_list_filtered[0]);
+        free(attrib_list_filtered);
+        return NULL;
+    }
+
+    free(attrib_list_filtered);
+
     self = wcore_calloc(sizeof(*self));
     if (self == NULL)
         return NULL;
 
+    self->sync_swap = sync_swap;
+    self->swap_interval = 1;
+
     if (!dpy->wl_compositor) {
         wcore_errorf(WAFFLE_ERROR_UNKNOWN, "wayland compositor not found");
         goto error;
     }
-    if (!dpy->wl_shell) {
+    if (!dpy->wl_shell && !dpy->xdg_wm_base) {
         wcore_errorf(WAFFLE_ERROR_UNKNOWN, "wayland shell not found");
         goto error;
     }
@@ -142,17 +291,12 @@ wayland_window_create(struct wcore_platform *wc_plat,
         goto error;
     }
 
-    self->wl_shell_surface = wl_shell_get_shell_surface(dpy->wl_shell,
-                                                        self->wl_surface);
-    if (!self->wl_shell_surface) {
-        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
-                     "wl_shell_get_shell_surface failed");
+    if (dpy->xdg_wm_base)
+        ok = wayland_window_init_xdg_shell(self, dpy);
+    else
+        ok = wayland_window_init_wl_shell(self, dpy);
+    if (!ok)
         goto error;
-    }
-
-    wl_shell_surface_add_listener(self->wl_shell_surface,
-                                  &shell_surface_listener,
-                                  NULL);
 
     self->wl_window = plat->wl_egl_window_create(self->wl_surface,
                                                  width, height);
@@ -172,10 +316,42 @@ wayland_window_create(struct wcore_platform *wc_plat,
     return &self->wegl.wcore;
 
 error:
-    wayland_window_destroy(&self->wegl.wcore);
+    wayland_window_teardown(self, plat);
     return NULL;
 }
 
+struct wcore_window*
+wayland_window_create_offscreen(struct wcore_platform *wc_plat,
+                                struct wcore_config *wc_config,
+                                int32_t width,
+                                int32_t height,
+                                const intptr_t attrib_list[])
+{
+    struct wayland_window *self;
+    struct wayland_platform *plat = wayland_platform(wegl_platform(wc_plat));
+    bool ok = true;
+
+    if (wcore_attrib_list_length(attrib_list) > 0) {
+        wcore_error_bad_attribute(attrib_list[0]);
+        return NULL;
+    }
+
+    self = wcore_calloc(sizeof(*self));
+    if (self == NULL)
+        return NULL;
+
+    // No wl_surface is created, so the compositor never learns about the
+    // window and no roundtrip is needed.
+    ok = wegl_pbuffer_init(&self->wegl, wc_config, width, height);
+    if (!ok)
+        goto error;
+
+    return &self->wegl.wcore;
+
+error:
+    wayland_window_teardown(self, plat);
+    return NULL;
+}
 
 bool
 wayland_window_show(struct wcore_window *wc_self)
@@ -184,7 +360,14 @@ wayland_window_show(struct wcore_window *wc_self)
     struct wayland_display *dpy = wayland_display(wc_self->display);
     bool ok = true;
 
-    wl_shell_surface_set_toplevel(self->wl_shell_surface);
+    // Offscreen windows are never shown.
+    if (!self->wl_surface)
+        return true;
+
+    // An xdg_toplevel is mapped by its first buffer, which the first swap
+    // attaches.
+    if (self->wl_shell_surface)
+        wl_shell_surface_set_toplevel(self->wl_shell_surface);
 
     ok = wayland_display_sync(dpy);
     if (!ok)
@@ -194,20 +377,234 @@ wayland_window_show(struct wcore_window *wc_self)
     return true;
 }
 
+static void
+frame_callback_done(void *data,
+                    struct wl_callback *callback,
+                    uint32_t time)
+{
+    struct wayland_window *self = data;
+
+    wl_callback_destroy(callback);
+    self->frame_callback = NULL;
+}
+
+static const struct wl_callback_listener frame_callback_listener = {
+    .done = frame_callback_done,
+};
+
+static void
+feedback_release(struct wayland_frame_feedback *fb)
+{
+    wp_presentation_feedback_destroy(fb->feedback);
+    fb->feedback = NULL;
+}
+
+static void
+feedback_listener_sync_output(void *data,
+                              struct wp_presentation_feedback *feedback,
+                              struct wl_output *output)
+{
+}
+
+static void
+feedback_listener_presented(void *data,
+                            struct wp_presentation_feedback *feedback,
+                            uint32_t tv_sec_hi,
+                            uint32_t tv_sec_lo,
+                            uint32_t tv_nsec,
+                            uint32_t refresh,
+                            uint32_t seq_hi,
+                            uint32_t seq_lo,
+                            uint32_t flags)
+{
+    struct wayland_frame_feedback *fb = data;
+    struct waffle_frame_timing *timing = &fb->window->timing;
+    uint64_t tv_sec = ((uint64_t) tv_sec_hi << 32) | tv_sec_lo;
+
+    // Feedback may arrive out of order if frames were discarded; never
+    // report an older frame over a newer one.
+    if (fb->frame > timing->frame) {
+        timing->frame = fb->frame;
+        timing->submit_ns = fb->submit_ns;
+        timing->present_ns = tv_sec * 1000000000 + tv_nsec;
+        timing->refresh_ns = refresh;
+    }
+
+    feedback_release(fb);
+}
+
+static void
+feedback_listener_discarded(void *data,
+                            struct wp_presentation_feedback *feedback)
+{
+    feedback_release(data);
+}
+
+static const struct wp_presentation_feedback_listener feedback_listener = {
+    .sync_output = feedback_listener_sync_output,
+    .presented = feedback_listener_presented,
+    .discarded = feedback_listener_discarded,
+};
+
+/// Request presentation feedback for the next commit of the surface, if the
+/// compositor supports it and a slot is free. Return the slot, or null.
+static struct wayland_frame_feedback*
+wayland_window_request_feedback(struct wayland_window *self,
+                                struct wayland_display *dpy)
+{
+    struct wayland_frame_feedback *fb = NULL;
+    struct timespec ts;
+
+    if (!dpy->wp_presentation)
+        return NULL;
+
+    for (int i = 0; i < WAYLAND_WINDOW_MAX_FEEDBACKS; i++) {
+        if (!self->feedbacks[i].feedback) {
+            fb = &self->feedbacks[i];
+            break;
+        }
+    }
+
+    if (!fb)
+        return NULL;
+
+    fb->feedback = wp_presentation_feedback(dpy->wp_presentation,
+                                            self->wl_surface);
+    if (!fb->feedback)
+        return NULL;
+
+    clock_gettime(dpy->presentation_clock, &ts);
+    fb->window = self;
+    fb->frame = self->frame_count + 1;
+    fb->submit_ns = (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+
+    wp_presentation_feedback_add_listener(fb->feedback,
+                                          &feedback_listener, fb);
+    return fb;
+}
+
+/// Block until the compositor signals the frame callback of the previous
+/// swap, which keeps at most one frame in flight.
+static bool
+wayland_window_wait_frame(struct wayland_window *self,
+                          struct wayland_display *dpy)
+{
+    while (self->frame_callback) {
+        if (wl_display_dispatch(dpy->wl_display) == -1) {
+            wcore_error_errno("error on wl_display");
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool
 wayland_window_swap_buffers(struct wcore_window *wc_self)
 {
+    return wayland_window_swap_buffers_with_damage(wc_self, NULL, 0);
+}
+
+bool
+wayland_window_swap_buffers_with_damage(struct wcore_window *wc_self,
+                                        const int32_t *rects,
+                                        int32_t n_rects)
+{
+    struct wayland_window *self = wayland_window(wc_self);
     struct wayland_display *dpy = wayland_display(wc_self->display);
+    struct wayland_frame_feedback *fb;
     bool ok;
 
-    ok = wegl_window_swap_buffers(wc_self);
-    if (!ok)
+    // Nothing is posted to the compositor.
+    if (!self->wl_surface)
+        return wegl_window_swap_buffers_with_damage(wc_self, rects, n_rects);
+
+    if (self->sync_swap) {
+        fb = wayland_window_request_feedback(self, dpy);
+
+        ok = wegl_window_swap_buffers_with_damage(wc_self, rects, n_rects);
+        if (!ok) {
+            if (fb)
+                feedback_release(fb);
+            return false;
+        }
+
+        self->frame_count++;
+        return wayland_display_sync(dpy);
+    }
+
+    if (self->swap_interval != 0) {
+        ok = wayland_window_wait_frame(self, dpy);
+        if (!ok)
+            return false;
+
+        // eglSwapBuffers commits the surface, and with it this frame request.
+        self->frame_callback = wl_surface_frame(self->wl_surface);
+        if (!self->frame_callback) {
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN, "wl_surface_frame failed");
+            return false;
+        }
+
+        wl_callback_add_listener(self->frame_callback,
+                                 &frame_callback_listener, self);
+    }
+
+    fb = wayland_window_request_feedback(self, dpy);
+
+    ok = wegl_window_swap_buffers_with_damage(wc_self, rects, n_rects);
+    if (!ok) {
+        // The surface was not committed, so neither the callback nor the
+        // feedback would ever fire.
+        if (self->frame_callback) {
+            wl_callback_destroy(self->frame_callback);
+            self->frame_callback = NULL;
+        }
+        if (fb)
+            feedback_release(fb);
         return false;
+    }
 
-    ok = wayland_display_sync(dpy);
-    if (!ok)
+    self->frame_count++;
+    return wayland_display_flush(dpy);
+}
+
+bool
+wayland_window_set_swap_interval(struct wcore_window *wc_self,
+                                 int32_t interval)
+{
+    struct wayland_window *self = wayland_window(wc_self);
+
+    if (!wegl_window_set_swap_interval(wc_self, interval))
         return false;
 
+    self->swap_interval = interval;
+    return true;
+}
+
+bool
+wayland_window_get_frame_timing(struct wcore_window *wc_self,
+                                struct waffle_frame_timing *timing)
+{
+    struct wayland_window *self = wayland_window(wc_self);
+    struct wayland_display *dpy = wayland_display(wc_self->display);
+
+    if (!self->wl_surface) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "offscreen windows are never presented");
+        return false;
+    }
+
+    if (!dpy->wp_presentation) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "the compositor lacks wp_presentation");
+        return false;
+    }
+
+    // Pick up feedback that has arrived since the last swap.
+    if (!wayland_display_flush(dpy))
+        return false;
+
+    *timing = self->timing;
     return true;
 }
 
@@ -220,6 +617,12 @@ wayland_window_resize(struct wcore_window *wc_self,
     struct wayland_platform *plat = wayland_platform(wegl_platform(wc_plat));
     struct wayland_display *dpy = wayland_display(self->wegl.wcore.display);
 
+    if (!self->wl_window) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "offscreen windows cannot be resized");
+        return false;
+    }
+
     plat->wl_egl_window_resize(wayland_window(wc_self)->wl_window,
                                width, height, 0, 0);
 
@@ -246,6 +649,8 @@ wayland_window_get_native(struct wcore_window *wc_self)
     n_window->wayland->wl_shell_surface = self->wl_shell_surface;
     n_window->wayland->wl_window = self->wl_window;
     n_window->wayland->egl_surface = self->wegl.egl;
+    n_window->wayland->xdg_surface = self->xdg_surface;
+    n_window->wayland->xdg_toplevel = self->xdg_toplevel;
 
     return n_window;
 }
@@ -29,18 +29,58 @@
 
 #include <EGL/egl.h>
 
+#include "waffle.h"
+
 #include "wcore_window.h"
 #include "wcore_util.h"
 
 #include "wegl_window.h"
 
 struct wcore_platform;
+struct wayland_window;
+
+/// Maximum number of swaps awaiting wp_presentation feedback. Swaps beyond
+/// that get no feedback, and hence no timing.
+#define WAYLAND_WINDOW_MAX_FEEDBACKS 4
+
+struct wayland_frame_feedback {
+    struct wayland_window *window;
+    struct wp_presentation_feedback *feedback;
+    uint64_t frame;
+    uint64_t submit_ns;
+};
 
 struct wayland_window {
     struct wl_surface *wl_surface;
-    struct wl_shell_surface *wl_shell_surface;
     struct wl_egl_window *wl_window;
 
+    /// The shell role of wl_surface. Either wl_shell_surface or the xdg pair
+    /// is set, depending on what the compositor provides.
+    struct wl_shell_surface *wl_shell_surface;
+    struct xdg_surface *xdg_surface;
+    struct xdg_toplevel *xdg_toplevel;
+
+    /// Set once the first xdg_surface.configure has been acked. No buffer
+    /// may be attached before then.
+    bool xdg_configured;
+
+    /// The frame callback requested by the last swap, or NULL once the
+    /// compositor has signalled it.
+    struct wl_callback *frame_callback;
+
+    /// If set, each swap waits for a roundtrip to the compositor.
+    bool sync_swap;
+
+    /// Last interval passed to eglSwapInterval. Zero disables the frame
+    /// callback throttling of swaps.
+    int32_t swap_interval;
+
+    /// Presentation feedback of swaps in flight. A slot is free if its
+    /// feedback is null.
+    struct wayland_frame_feedback feedbacks[WAYLAND_WINDOW_MAX_FEEDBACKS];
+    uint64_t frame_count;
+    struct waffle_frame_timing timing;
+
     struct wegl_window wegl;
 };
 
@@ -63,6 +103,13 @@ wayland_window_create(struct wcore_platform *wc_plat,
                       int32_t height,
                       const intptr_t attrib_list[]);
 
+struct wcore_window*
+wayland_window_create_offscreen(struct wcore_platform *wc_plat,
+                                struct wcore_config *wc_config,
+                                int32_t width,
+                                int32_t height,
+                                const intptr_t attrib_list[]);
+
 bool
 wayland_window_destroy(struct wcore_window *wc_self);
 
@@ -72,6 +119,19 @@ wayland_window_show(struct wcore_window *wc_self);
 bool
 wayland_window_swap_buffers(struct wcore_window *wc_self);
 
+bool
+wayland_window_swap_buffers_with_damage(struct wcore_window *wc_self,
+                                        const int32_t *rects,
+                                        int32_t n_rects);
+
+bool
+wayland_window_set_swap_interval(struct wcore_window *wc_self,
+                                 int32_t interval);
+
+bool
+wayland_window_get_frame_timing(struct wcore_window *wc_self,
+                                struct waffle_frame_timing *timing);
+
 bool
 wayland_window_resize(struct wcore_window *wc_self,
                       int32_t width, int32_t height);
@@ -36,6 +36,7 @@ wayland_wrapper_teardown(void);
 
 
 // Data symbols
+const struct wl_interface *wfl_wl_callback_interface;
 const struct wl_interface *wfl_wl_compositor_interface;
 const struct wl_interface *wfl_wl_registry_interface;
 const struct wl_interface *wfl_wl_shell_interface;
@@ -58,6 +59,27 @@ void
 int
 (*wfl_wl_display_roundtrip)(struct wl_display *display);
 
+int
+(*wfl_wl_display_flush)(struct wl_display *display);
+
+int
+(*wfl_wl_display_dispatch)(struct wl_display *display);
+
+int
+(*wfl_wl_display_dispatch_pending)(struct wl_display *display);
+
+int
+(*wfl_wl_display_get_fd)(struct wl_display *display);
+
+int
+(*wfl_wl_display_prepare_read)(struct wl_display *display);
+
+int
+(*wfl_wl_display_read_events)(struct wl_display *display);
+
+void
+(*wfl_wl_display_cancel_read)(struct wl_display *display);
+
 
 void
 (*wfl_wl_proxy_destroy)(struct wl_proxy *proxy);
@@ -75,10 +97,32 @@ struct wl_proxy *
                                     const struct wl_interface *interface,
                                     ...);
 
+struct wl_proxy *
+(*wfl_wl_proxy_marshal_constructor_versioned)(struct wl_proxy *proxy,
+                                              uint32_t opcode,
+                                              const struct wl_interface *interface,
+                                              uint32_t version,
+                                              ...);
+
+// Used by the inline functions of wayland-scanner >= 1.20. Resolved only when
+// waffle is built with such a scanner or wayland-client headers; null
+// otherwise, when nothing references it.
+struct wl_proxy *
+(*wfl_wl_proxy_marshal_flags)(struct wl_proxy *proxy,
+                              uint32_t opcode,
+                              const struct wl_interface *interface,
+                              uint32_t version,
+                              uint32_t flags,
+                              ...);
+
+uint32_t
+(*wfl_wl_proxy_get_version)(struct wl_proxy *proxy);
+
 #ifdef _WAYLAND_CLIENT_H
 #error Do not include wayland-client.h ahead of wayland_wrapper.h
 #endif
 
+#define wl_callback_interface (*wfl_wl_callback_interface)
 #define wl_compositor_interface (*wfl_wl_compositor_interface)
 #define wl_registry_interface (*wfl_wl_registry_interface)
 #define wl_shell_interface (*wfl_wl_shell_interface)
@@ -88,7 +132,17 @@ struct wl_proxy *
 #define wl_display_connect (*wfl_wl_display_connect)
 #define wl_display_disconnect (*wfl_wl_display_disconnect)
 #define wl_display_roundtrip (*wfl_wl_display_roundtrip)
+#define wl_display_flush (*wfl_wl_display_flush)
+#define wl_display_dispatch (*wfl_wl_display_dispatch)
+#define wl_display_dispatch_pending (*wfl_wl_display_dispatch_pending)
+#define wl_display_get_fd (*wfl_wl_display_get_fd)
+#define wl_display_prepare_read (*wfl_wl_display_prepare_read)
+#define wl_display_read_events (*wfl_wl_display_read_events)
+#define wl_display_cancel_read (*wfl_wl_display_cancel_read)
 #define wl_proxy_destroy (*wfl_wl_proxy_destroy)
 #define wl_proxy_add_listener (*wfl_wl_proxy_add_listener)
 #define wl_proxy_marshal (*wfl_wl_proxy_marshal)
 #define wl_proxy_marshal_constructor (*wfl_wl_proxy_marshal_constructor)
+#define wl_proxy_marshal_constructor_versioned (*wfl_wl_proxy_marshal_constructor_versioned)
+#define wl_proxy_marshal_flags (*wfl_wl_proxy_marshal_flags)
+#define wl_proxy_get_version (*wfl_wl_proxy_get_version)
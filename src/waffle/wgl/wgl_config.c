@@ -30,6 +30,7 @@
 
 #include "wcore_config_attrs.h"
 #include "wcore_error.h"
+#include "wcore_tinfo.h"
 
 #include "wgl_config.h"
 #include "wgl_display.h"
@@ -223,6 +224,7 @@ wgl_config_choose_native(struct wgl_config *config,
         bool ok;
 
         // But first we need a current context to use it...
+        wcore_tinfo_clear_binding();
         ok = wglMakeCurrent(dpy->hDC, dpy->hglrc);
         if (!ok)
             return false;
@@ -29,6 +29,7 @@
 #include "c99_compat.h"
 
 #include "wcore_error.h"
+#include "wcore_tinfo.h"
 
 #include "wgl_display.h"
 #include "wgl_dl.h"
@@ -151,9 +152,12 @@ wgl_display_set_extensions(struct wgl_display *dpy)
         return false;
     }
 
-    dpy->ARB_create_context                     = waffle_is_extension_in_string(extensions, "WGL_ARB_create_context");
-    dpy->ARB_create_context_profile             = waffle_is_extension_in_string(extensions, "WGL_ARB_create_context_profile");
-    dpy->EXT_create_context_es_profile          = waffle_is_extension_in_string(extensions, "WGL_EXT_create_context_es_profile");
+    if (!wcore_display_set_extensions(&dpy->wcore, extensions))
+        return false;
+
+    dpy->ARB_create_context                     = wcore_display_has_extension(&dpy->wcore, "WGL_ARB_create_context");
+    dpy->ARB_create_context_profile             = wcore_display_has_extension(&dpy->wcore, "WGL_ARB_create_context_profile");
+    dpy->EXT_create_context_es_profile          = wcore_display_has_extension(&dpy->wcore, "WGL_EXT_create_context_es_profile");
 
     // The WGL_EXT_create_context_es2_profile spec, version 5 2012/04/06,
     // states that WGL_EXT_create_context_es_profile is an alias of
@@ -166,10 +170,12 @@ wgl_display_set_extensions(struct wgl_display *dpy)
     else {
         // Assume that WGL does not implement version 3 of the extension, in
         // which case the ES contexts WGL is capable of creating is ES2.
-        dpy->EXT_create_context_es2_profile = waffle_is_extension_in_string(extensions, "WGL_EXT_create_context_es2_profile");
+        dpy->EXT_create_context_es2_profile = wcore_display_has_extension(&dpy->wcore, "WGL_EXT_create_context_es2_profile");
     }
 
-    dpy->ARB_pixel_format = waffle_is_extension_in_string(extensions, "WGL_ARB_pixel_format");
+    dpy->ARB_pixel_format = wcore_display_has_extension(&dpy->wcore, "WGL_ARB_pixel_format");
+    dpy->EXT_swap_control = wcore_display_has_extension(&dpy->wcore, "WGL_EXT_swap_control");
+    dpy->EXT_swap_control_tear = wcore_display_has_extension(&dpy->wcore, "WGL_EXT_swap_control_tear");
 
     return true;
 }
@@ -195,6 +201,15 @@ wgl_display_set_func_ptrs(struct wgl_display *dpy)
         }
     }
 
+    if (dpy->EXT_swap_control) {
+        dpy->wglSwapIntervalEXT = (void *)wglGetProcAddress("wglSwapIntervalEXT");
+        if (!dpy->wglSwapIntervalEXT) {
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                         "wglGetProcAddress(\"wglSwapIntervalEXT\") failed");
+            return false;
+        }
+    }
+
     return true;
 }
 
@@ -225,6 +240,8 @@ wgl_display_connect(struct wcore_platform *wc_plat,
     if (!self->hglrc)
         goto error;
 
+    // This replaces the thread's binding, and the one below unbinds it.
+    wcore_tinfo_clear_binding();
     ok = wglMakeCurrent(self->hDC, self->hglrc);
     if (!ok)
         goto error;
@@ -45,6 +45,8 @@ typedef BOOL (__stdcall *PFNWGLCHOOSEPIXELFORMATARBPROC )(HDC hdc,
                                                           int * piFormats,
                                                           unsigned int * nNumFormats);
 
+typedef BOOL (__stdcall *PFNWGLSWAPINTERVALEXTPROC)(int interval);
+
 struct wgl_display {
     struct wcore_display wcore;
 
@@ -58,9 +60,12 @@ struct wgl_display {
     bool EXT_create_context_es_profile;
     bool EXT_create_context_es2_profile;
     bool ARB_pixel_format;
+    bool EXT_swap_control;
+    bool EXT_swap_control_tear;
 
     PFNWGLCREATECONTEXTATTRIBSARBPROC wglCreateContextAttribsARB;
     PFNWGLCHOOSEPIXELFORMATARBPROC wglChoosePixelFormatARB;
+    PFNWGLSWAPINTERVALEXTPROC wglSwapIntervalEXT;
 };
 
 static inline struct wgl_display*
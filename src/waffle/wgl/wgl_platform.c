@@ -27,6 +27,7 @@
 #include <windows.h>
 
 #include "wcore_error.h"
+#include "wcore_gl_fence.h"
 
 #include "wgl_config.h"
 #include "wgl_context.h"
@@ -109,6 +110,10 @@ wgl_platform_create(void)
         goto error;
     self->class_name = wfl_class_name;
 
+    // wglGetProcAddress() returns pointers that are specific to the
+    // current context's pixel format.
+    self->wcore.proc_address_per_context = true;
+
     self->wcore.vtbl = &wgl_platform_vtbl;
     return &self->wcore;
 
@@ -168,6 +173,14 @@ static const struct wcore_platform_vtbl wgl_platform_vtbl = {
         .show = wgl_window_show,
         .resize = wgl_window_resize,
         .swap_buffers = wgl_window_swap_buffers,
+        .set_swap_interval = wgl_window_set_swap_interval,
         .get_native = NULL,
     },
+
+    .fence = {
+        .create = wcore_gl_fence_create,
+        .destroy = wcore_gl_fence_destroy,
+        .client_wait = wcore_gl_fence_client_wait,
+        .server_wait = wcore_gl_fence_server_wait,
+    },
 };
@@ -29,6 +29,8 @@
 #include "wcore_error.h"
 
 #include "wgl_config.h"
+#include "wgl_display.h"
+#include "wgl_error.h"
 #include "wgl_platform.h"
 #include "wgl_window.h"
 
@@ -223,3 +225,38 @@ wgl_window_swap_buffers(struct wcore_window *wc_self)
 
     return SwapBuffers(self->hDC);
 }
+
+bool
+wgl_window_set_swap_interval(struct wcore_window *wc_self,
+                             int32_t interval)
+{
+    struct wgl_window *self = wgl_window(wc_self);
+    struct wgl_display *dpy = wgl_display(wc_self->display);
+
+    if (!dpy->EXT_swap_control) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "WGL_EXT_swap_control is not supported");
+        return false;
+    }
+
+    if (interval < 0 && !dpy->EXT_swap_control_tear) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "WGL_EXT_swap_control_tear is required for negative "
+                     "swap intervals");
+        return false;
+    }
+
+    // wglSwapIntervalEXT acts on the window of the current context.
+    if (wglGetCurrentDC() != self->hDC) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "window is not current on this thread");
+        return false;
+    }
+
+    if (!dpy->wglSwapIntervalEXT(interval)) {
+        wgl_error_failed_func("wglSwapIntervalEXT", GetLastError());
+        return false;
+    }
+
+    return true;
+}
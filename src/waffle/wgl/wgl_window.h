@@ -74,5 +74,9 @@ wgl_window_resize(struct wcore_window *wc_self,
 bool
 wgl_window_swap_buffers(struct wcore_window *wc_self);
 
+bool
+wgl_window_set_swap_interval(struct wcore_window *wc_self,
+                             int32_t interval);
+
 union waffle_native_window*
 wgl_window_get_native(struct wcore_window *wc_self);
@@ -24,6 +24,8 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assert.h>
+#include <stdlib.h>
+#include <time.h>
 
 #include "wcore_error.h"
 
@@ -66,6 +68,31 @@ get_xcb_screen(const xcb_setup_t *setup, int screen)
     return NULL;
 }
 
+#ifdef WAFFLE_HAS_XCB_PRESENT
+/// Select Present CompleteNotify events for the window, on a queue of their
+/// own. Failure is not fatal; the window merely lacks frame timing.
+static void
+x11_window_init_present(struct x11_window *self, xcb_connection_t *conn)
+{
+    const xcb_query_extension_reply_t *ext =
+        xcb_get_extension_data(conn, &xcb_present_id);
+
+    if (!ext || !ext->present)
+        return;
+
+    self->present_eid = xcb_generate_id(conn);
+    self->present_events = xcb_register_for_special_xge(conn,
+                                                        &xcb_present_id,
+                                                        self->present_eid,
+                                                        NULL);
+    if (!self->present_events)
+        return;
+
+    xcb_present_select_input(conn, self->present_eid, self->xcb,
+                             XCB_PRESENT_EVENT_MASK_COMPLETE_NOTIFY);
+}
+#endif
+
 bool
 x11_window_init(struct x11_window *self,
                 struct x11_display *dpy,
@@ -157,6 +184,9 @@ x11_window_init(struct x11_window *self,
 
     self->display = dpy;
     self->xcb = window;
+#ifdef WAFFLE_HAS_XCB_PRESENT
+    x11_window_init_present(self, conn);
+#endif
     goto end;
 
 error:
@@ -183,6 +213,12 @@ x11_window_teardown(struct x11_window *self)
     if (!self->xcb)
         return true;
 
+#ifdef WAFFLE_HAS_XCB_PRESENT
+    if (self->present_events)
+        xcb_unregister_for_special_event(self->display->xcb,
+                                         self->present_events);
+#endif
+
     cookie = xcb_destroy_window_checked(self->display->xcb, self->xcb);
     error = xcb_request_check(self->display->xcb, cookie);
 
@@ -236,3 +272,126 @@ x11_window_resize(struct x11_window *self, int32_t width, int32_t height)
 
     return true;
 }
+
+uint64_t
+x11_window_get_time_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+void
+x11_window_frame_submitted(struct x11_window *self, uint64_t submit_ns)
+{
+    self->frame_count++;
+
+#ifdef WAFFLE_HAS_XCB_PRESENT
+    unsigned tail;
+
+    if (!self->present_events)
+        return;
+
+    // Forget the oldest swap if its presentation never arrived.
+    if (self->pending_count == X11_WINDOW_MAX_PENDING_FRAMES) {
+        self->pending_head = (self->pending_head + 1)
+                           % X11_WINDOW_MAX_PENDING_FRAMES;
+        self->pending_count--;
+    }
+
+    tail = (self->pending_head + self->pending_count)
+         % X11_WINDOW_MAX_PENDING_FRAMES;
+    self->pending[tail].frame = self->frame_count;
+    self->pending[tail].submit_ns = submit_ns;
+    self->pending[tail].serial = (uint32_t) self->frame_count;
+    self->pending_count++;
+#else
+    (void) submit_ns;
+#endif
+}
+
+#ifdef WAFFLE_HAS_XCB_PRESENT
+static void
+x11_window_handle_complete(struct x11_window *self,
+                           const xcb_present_complete_notify_event_t *ev)
+{
+    unsigned head = self->pending_head;
+    unsigned i;
+
+    if (ev->kind != XCB_PRESENT_COMPLETE_KIND_PIXMAP)
+        return;
+
+    for (i = 0; i < self->pending_count; i++) {
+        head = (self->pending_head + i) % X11_WINDOW_MAX_PENDING_FRAMES;
+        if (self->pending[head].serial == ev->serial)
+            break;
+    }
+
+    if (i == self->pending_count)
+        return;
+
+    // Presents complete in order, so the older swaps will never complete.
+    self->pending_head = (head + 1) % X11_WINDOW_MAX_PENDING_FRAMES;
+    self->pending_count -= i + 1;
+    self->presented = true;
+
+    // The frame was never shown.
+    if (ev->mode == XCB_PRESENT_COMPLETE_MODE_SKIP)
+        return;
+
+    self->timing.frame = self->pending[head].frame;
+    self->timing.submit_ns = self->pending[head].submit_ns;
+    self->timing.present_ns = ev->ust * 1000;
+
+    if (self->last_msc && ev->msc > self->last_msc) {
+        self->timing.refresh_ns = (ev->ust - self->last_ust) * 1000
+                                / (ev->msc - self->last_msc);
+    }
+
+    self->last_ust = ev->ust;
+    self->last_msc = ev->msc;
+}
+#endif // WAFFLE_HAS_XCB_PRESENT
+
+bool
+x11_window_get_frame_timing(struct x11_window *self,
+                            struct waffle_frame_timing *timing)
+{
+#ifdef WAFFLE_HAS_XCB_PRESENT
+    xcb_generic_event_t *ev;
+
+    if (!self->present_events) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "the X server lacks the Present extension");
+        return false;
+    }
+
+    while ((ev = xcb_poll_for_special_event(self->display->xcb,
+                                            self->present_events))) {
+        const xcb_present_generic_event_t *pev = (void *) ev;
+
+        if (pev->evtype == XCB_PRESENT_COMPLETE_NOTIFY)
+            x11_window_handle_complete(self, (void *) ev);
+
+        free(ev);
+    }
+
+    if (!self->presented &&
+        self->frame_count > X11_WINDOW_MAX_PENDING_FRAMES) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "no Present CompleteNotify matched the window's swaps; "
+                     "the driver does not present through Present");
+        return false;
+    }
+
+    *timing = self->timing;
+    return true;
+#else
+    (void) self;
+    (void) timing;
+    wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                 "waffle was built without xcb-present");
+    return false;
+#endif
+}
@@ -28,12 +28,55 @@
 #include <stdbool.h>
 
 #include <X11/Xlib-xcb.h>
+#ifdef WAFFLE_HAS_XCB_PRESENT
+#include <xcb/present.h>
+#endif
+
+#include "waffle.h"
 
 struct x11_display;
 
+/// Maximum number of swaps whose submit time is remembered while waiting for
+/// their Present CompleteNotify. Older swaps are forgotten.
+#define X11_WINDOW_MAX_PENDING_FRAMES 8
+
 struct x11_window {
     struct x11_display *display;
     xcb_window_t xcb;
+
+#ifdef WAFFLE_HAS_XCB_PRESENT
+    /// Present CompleteNotify events for the window, used for frame timing.
+    /// Null if the server lacks the Present extension.
+    xcb_special_event_t *present_events;
+    uint32_t present_eid;
+#endif
+
+    /// Swaps not yet presented, oldest first, in a ring buffer.
+    ///
+    /// The serial is the one the driver is expected to pass to
+    /// PresentPixmap: DRI3 numbers a drawable's presents by its swap count,
+    /// from 1. CompleteNotify events with other serials were not caused by
+    /// our swaps and are ignored.
+    struct {
+        uint64_t frame;
+        uint64_t submit_ns;
+        uint32_t serial;
+    } pending[X11_WINDOW_MAX_PENDING_FRAMES];
+    unsigned pending_head;
+    unsigned pending_count;
+
+    /// Whether any CompleteNotify has matched a swap. If none has after
+    /// X11_WINDOW_MAX_PENDING_FRAMES swaps, the driver does not present
+    /// through Present, and frame timing is unsupported.
+    bool presented;
+
+    uint64_t frame_count;
+
+    /// The most recent presentation, and its Present timestamps, from which
+    /// the next presentation derives the refresh interval.
+    struct waffle_frame_timing timing;
+    uint64_t last_ust;
+    uint64_t last_msc;
 };
 
 bool
@@ -51,3 +94,17 @@ x11_window_show(struct x11_window *self);
 
 bool
 x11_window_resize(struct x11_window *self, int32_t width, int32_t height);
+
+/// Return the current time in nanoseconds, on the clock of Present's
+/// timestamps.
+uint64_t
+x11_window_get_time_ns(void);
+
+/// Record that a swap was submitted at @a submit_ns, so that its
+/// presentation can be matched to it later.
+void
+x11_window_frame_submitted(struct x11_window *self, uint64_t submit_ns);
+
+bool
+x11_window_get_frame_timing(struct x11_window *self,
+                            struct waffle_frame_timing *timing);
@@ -31,6 +31,8 @@
 
 #include "wegl_config.h"
 #include "wegl_context.h"
+#include "wegl_fence.h"
+#include "wegl_image.h"
 #include "wegl_platform.h"
 #include "wegl_util.h"
 
@@ -71,7 +73,7 @@ xegl_platform_create(void)
     if (self == NULL)
         return NULL;
 
-    ok = wegl_platform_init(&self->wegl);
+    ok = wegl_platform_init(&self->wegl, EGL_PLATFORM_X11_KHR);
     if (!ok)
         goto error;
 
@@ -106,6 +108,24 @@ xegl_dl_sym(struct wcore_platform *wc_self,
     return linux_platform_dl_sym(self->linux, waffle_dl, name);
 }
 
+static int32_t
+xegl_dl_sym_many(struct wcore_platform *wc_self,
+                 int32_t waffle_dl,
+                 int32_t count,
+                 const char *const *names,
+                 void **syms)
+{
+    struct xegl_platform *self = xegl_platform(wegl_platform(wc_self));
+    return linux_platform_dl_sym_many(self->linux, waffle_dl, count, names, syms);
+}
+
+static void
+xegl_dl_rescan(struct wcore_platform *wc_self)
+{
+    struct xegl_platform *self = xegl_platform(wegl_platform(wc_self));
+    linux_platform_dl_rescan(self->linux);
+}
+
 static union waffle_native_config*
 xegl_config_get_native(struct wcore_config *wc_config)
 {
@@ -147,6 +167,8 @@ static const struct wcore_platform_vtbl xegl_platform_vtbl = {
     .get_proc_address = wegl_get_proc_address,
     .dl_can_open = xegl_dl_can_open,
     .dl_sym = xegl_dl_sym,
+    .dl_sym_many = xegl_dl_sym_many,
+    .dl_rescan = xegl_dl_rescan,
 
     .display = {
         .connect = xegl_display_connect,
@@ -169,10 +191,30 @@ static const struct wcore_platform_vtbl xegl_platform_vtbl = {
 
     .window = {
         .create = xegl_window_create,
+        .create_offscreen = xegl_window_create_offscreen,
         .destroy = xegl_window_destroy,
         .show = xegl_window_show,
         .resize = xegl_window_resize,
-        .swap_buffers = wegl_window_swap_buffers,
+        .swap_buffers = xegl_window_swap_buffers,
+        .swap_buffers_with_damage = xegl_window_swap_buffers_with_damage,
+        .get_frame_timing = xegl_window_get_frame_timing,
+        .query_buffer_age = wegl_window_query_buffer_age,
+        .set_damage_region = wegl_window_set_damage_region,
+        .set_swap_interval = wegl_window_set_swap_interval,
         .get_native = xegl_window_get_native,
     },
+
+    .fence = {
+        .create = wegl_fence_create,
+        .destroy = wegl_fence_destroy,
+        .client_wait = wegl_fence_client_wait,
+        .server_wait = wegl_fence_server_wait,
+    },
+
+    .image = {
+        .create_from_texture = wegl_image_create_from_texture,
+        .create_from_renderbuffer = wegl_image_create_from_renderbuffer,
+        .destroy = wegl_image_destroy,
+        .bind_texture = wegl_image_bind_texture,
+    },
 };
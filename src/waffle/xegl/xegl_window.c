@@ -111,17 +111,100 @@ error:
     return NULL;
 }
 
+struct wcore_window*
+xegl_window_create_offscreen(struct wcore_platform *wc_plat,
+                             struct wcore_config *wc_config,
+                             int32_t width,
+                             int32_t height,
+                             const intptr_t attrib_list[])
+{
+    struct xegl_window *self;
+    bool ok = true;
+
+    if (wcore_attrib_list_length(attrib_list) > 0) {
+        wcore_error_bad_attribute(attrib_list[0]);
+        return NULL;
+    }
+
+    self = wcore_calloc(sizeof(*self));
+    if (self == NULL)
+        return NULL;
+
+    // No X window is created, so self->x11.xcb stays 0.
+    ok = wegl_pbuffer_init(&self->wegl, wc_config, width, height);
+    if (!ok)
+        goto error;
+
+    return &self->wegl.wcore;
+
+error:
+    xegl_window_destroy(&self->wegl.wcore);
+    return NULL;
+}
+
 bool
 xegl_window_show(struct wcore_window *wc_self)
 {
-    return x11_window_show(&xegl_window(wc_self)->x11);
+    struct xegl_window *self = xegl_window(wc_self);
+
+    // Offscreen windows are never shown.
+    if (!self->x11.xcb)
+        return true;
+
+    return x11_window_show(&self->x11);
 }
 
 bool
 xegl_window_resize(struct wcore_window *wc_self,
                    int32_t width, int32_t height)
 {
-   return x11_window_resize(&xegl_window(wc_self)->x11, width, height);
+    struct xegl_window *self = xegl_window(wc_self);
+
+    if (!self->x11.xcb) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "offscreen windows cannot be resized");
+        return false;
+    }
+
+    return x11_window_resize(&self->x11, width, height);
+}
+
+bool
+xegl_window_swap_buffers(struct wcore_window *wc_self)
+{
+    return xegl_window_swap_buffers_with_damage(wc_self, NULL, 0);
+}
+
+bool
+xegl_window_swap_buffers_with_damage(struct wcore_window *wc_self,
+                                     const int32_t *rects,
+                                     int32_t n_rects)
+{
+    struct xegl_window *self = xegl_window(wc_self);
+    uint64_t submit_ns = x11_window_get_time_ns();
+
+    if (!wegl_window_swap_buffers_with_damage(wc_self, rects, n_rects))
+        return false;
+
+    if (self->x11.xcb)
+        x11_window_frame_submitted(&self->x11, submit_ns);
+
+    return true;
+}
+
+bool
+xegl_window_get_frame_timing(struct wcore_window *wc_self,
+                             struct waffle_frame_timing *timing)
+{
+    struct xegl_window *self = xegl_window(wc_self);
+
+    if (!self->x11.xcb) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "offscreen windows are never presented");
+        return false;
+    }
+
+    return x11_window_get_frame_timing(&self->x11, timing);
 }
 
 union waffle_native_window*
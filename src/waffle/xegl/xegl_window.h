@@ -60,6 +60,13 @@ xegl_window_create(struct wcore_platform *wc_plat,
                    int32_t height,
                    const intptr_t attrib_list[]);
 
+struct wcore_window*
+xegl_window_create_offscreen(struct wcore_platform *wc_plat,
+                             struct wcore_config *wc_config,
+                             int32_t width,
+                             int32_t height,
+                             const intptr_t attrib_list[]);
+
 bool
 xegl_window_destroy(struct wcore_window *wc_self);
 
@@ -70,5 +77,17 @@ bool
 xegl_window_resize(struct wcore_window *wc_self,
                    int32_t width, int32_t height);
 
+bool
+xegl_window_swap_buffers(struct wcore_window *wc_self);
+
+bool
+xegl_window_swap_buffers_with_damage(struct wcore_window *wc_self,
+                                     const int32_t *rects,
+                                     int32_t n_rects);
+
+bool
+xegl_window_get_frame_timing(struct wcore_window *wc_self,
+                             struct waffle_frame_timing *timing);
+
 union waffle_native_window*
 xegl_window_get_native(struct wcore_window *wc_self);
@@ -172,6 +172,20 @@ gl_basic_init(int32_t waffle_platform)
     ASSERT_TRUE(waffle_init(init_attrib_list));
 }
 
+/// Re-initialize waffle with WAFFLE_MAKE_CURRENT_ELISION set to false.
+static void
+gl_basic_init_no_elision(int32_t waffle_platform)
+{
+    const int32_t init_attrib_list[] = {
+        WAFFLE_PLATFORM, waffle_platform,
+        WAFFLE_MAKE_CURRENT_ELISION, false,
+        0,
+    };
+
+    ASSERT_TRUE(waffle_teardown());
+    ASSERT_TRUE(waffle_init(init_attrib_list));
+}
+
 #define gl_basic_draw(...) \
     \
     gl_basic_draw__((struct gl_basic_draw_args__) { \
@@ -181,6 +195,7 @@ gl_basic_init(int32_t waffle_platform)
         .forward_compatible = false, \
         .debug = false, \
         .alpha = false, \
+        .offscreen = false, \
         .expect_error = WAFFLE_NO_ERROR, \
         __VA_ARGS__ \
         })
@@ -193,6 +208,7 @@ struct gl_basic_draw_args__ {
     bool forward_compatible;
     bool debug;
     bool alpha;
+    bool offscreen;
 };
 
 static void
@@ -205,6 +221,7 @@ gl_basic_draw__(struct gl_basic_draw_args__ args)
     bool context_forward_compatible = args.forward_compatible;
     bool context_debug = args.debug;
     bool alpha = args.alpha;
+    bool offscreen = args.offscreen;
 
     int32_t libgl;
 
@@ -219,6 +236,7 @@ gl_basic_draw__(struct gl_basic_draw_args__ args)
     const intptr_t window_attrib_list[] = {
         WAFFLE_WINDOW_WIDTH,    WINDOW_WIDTH,
         WAFFLE_WINDOW_HEIGHT,   WINDOW_HEIGHT,
+        WAFFLE_WINDOW_OFFSCREEN, offscreen,
         0,
     };
 
@@ -277,7 +295,16 @@ gl_basic_draw__(struct gl_basic_draw_args__ args)
         }
     }
 
-    ASSERT_TRUE(window = waffle_window_create2(config, window_attrib_list));
+    window = waffle_window_create2(config, window_attrib_list);
+    if (!window) {
+        if (offscreen &&
+            waffle_error_get_code() == WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM) {
+            TEST_SKIP();
+        }
+        else {
+            TEST_FAIL();
+        }
+    }
     ASSERT_TRUE(waffle_window_show(window));
 
     ctx = waffle_context_create(config, NULL);
@@ -347,6 +374,202 @@ gl_basic_draw__(struct gl_basic_draw_args__ args)
     ASSERT_TRUE(waffle_display_disconnect(dpy));
 }
 
+/// Check that the current context draws, by clearing and reading back one
+/// pixel.
+static void
+gl_basic_probe_current(void)
+{
+    memset(pixels, 0, 4);
+    ASSERT_GL(glClearColor(RED_F, GREEN_F, BLUE_F, ALPHA_F));
+    ASSERT_GL(glClear(GL_COLOR_BUFFER_BIT));
+    ASSERT_GL(glReadPixels(0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+    ASSERT_TRUE(pixels[0] == RED_UB);
+    ASSERT_TRUE(pixels[1] == GREEN_UB);
+    ASSERT_TRUE(pixels[2] == BLUE_UB);
+}
+
+/// Check the bookkeeping of waffle_make_current() for a platform initialized
+/// with WAFFLE_MAKE_CURRENT_ELISION equal to @a elision.
+static void
+gl_basic_make_current(bool elision)
+{
+    const int32_t config_attrib_list[] = {
+        WAFFLE_CONTEXT_API,     WAFFLE_CONTEXT_OPENGL_ES2,
+        0,
+    };
+
+    struct waffle_display *dpy = NULL;
+    struct waffle_config *config = NULL;
+    struct waffle_window *window = NULL;
+    struct waffle_context *ctx = NULL;
+    struct waffle_context *other_ctx = NULL;
+    struct waffle_make_current_stats before, after;
+
+    ASSERT_TRUE(dpy = waffle_display_connect(NULL));
+
+    config = waffle_config_choose(dpy, config_attrib_list);
+    if (!config) {
+        if (waffle_error_get_code() == WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM)
+            TEST_SKIP();
+        else
+            TEST_FAIL();
+    }
+
+    ASSERT_TRUE(window = waffle_window_create(config, WINDOW_WIDTH,
+                                              WINDOW_HEIGHT));
+    ASSERT_TRUE(ctx = waffle_context_create(config, NULL));
+
+    ASSERT_TRUE(glClear         = waffle_dl_sym(WAFFLE_DL_OPENGL_ES2, "glClear"));
+    ASSERT_TRUE(glClearColor    = waffle_dl_sym(WAFFLE_DL_OPENGL_ES2, "glClearColor"));
+    ASSERT_TRUE(glGetError      = waffle_dl_sym(WAFFLE_DL_OPENGL_ES2, "glGetError"));
+    ASSERT_TRUE(glReadPixels    = waffle_dl_sym(WAFFLE_DL_OPENGL_ES2, "glReadPixels"));
+
+    // Repeat a bind.
+    ASSERT_TRUE(waffle_make_current(dpy, window, ctx));
+    ASSERT_TRUE(waffle_get_make_current_stats(&before));
+    ASSERT_TRUE(waffle_make_current(dpy, window, ctx));
+    ASSERT_TRUE(waffle_get_make_current_stats(&after));
+
+    ASSERT_TRUE(after.calls == before.calls + 1);
+    ASSERT_TRUE(after.rebinds == before.rebinds + 1);
+    ASSERT_TRUE(after.elided == before.elided + (elision ? 1 : 0));
+    gl_basic_probe_current();
+
+    // A destroyed object's address may be reused by a new one, so a
+    // binding made before any destroy is never repeated.
+    ASSERT_TRUE(other_ctx = waffle_context_create(config, NULL));
+    ASSERT_TRUE(waffle_context_destroy(other_ctx));
+
+    before = after;
+    ASSERT_TRUE(waffle_make_current(dpy, window, ctx));
+    ASSERT_TRUE(waffle_get_make_current_stats(&after));
+
+    ASSERT_TRUE(after.calls == before.calls + 1);
+    ASSERT_TRUE(after.rebinds == before.rebinds);
+    ASSERT_TRUE(after.elided == before.elided);
+    gl_basic_probe_current();
+
+    // Destroy the current context. Its replacement may get the same
+    // address, but binding it is never a rebind.
+    ASSERT_TRUE(waffle_context_destroy(ctx));
+    ASSERT_TRUE(ctx = waffle_context_create(config, NULL));
+
+    before = after;
+    ASSERT_TRUE(waffle_make_current(dpy, window, ctx));
+    ASSERT_TRUE(waffle_get_make_current_stats(&after));
+
+    ASSERT_TRUE(after.calls == before.calls + 1);
+    ASSERT_TRUE(after.rebinds == before.rebinds);
+    ASSERT_TRUE(after.elided == before.elided);
+    gl_basic_probe_current();
+
+    // Teardown.
+    ABORT_IF(!waffle_make_current(dpy, NULL, NULL));
+    ASSERT_TRUE(waffle_window_destroy(window));
+    ASSERT_TRUE(waffle_context_destroy(ctx));
+    ASSERT_TRUE(waffle_config_destroy(config));
+    ASSERT_TRUE(waffle_display_disconnect(dpy));
+}
+
+/// Check waffle_dl_sym_many() if @a use_dl, else
+/// waffle_get_proc_address_many(), against the single-symbol lookups.
+static void
+gl_basic_sym_many(bool use_dl)
+{
+    const int32_t config_attrib_list[] = {
+        WAFFLE_CONTEXT_API,     WAFFLE_CONTEXT_OPENGL_ES2,
+        0,
+    };
+
+    // Mixed hits and misses, a null name and a missing symbol.
+    const char *const names[] = {
+        "glClear",
+        NULL,
+        "waffle_no_such_symbol",
+        "glFlush",
+    };
+
+    const int32_t dl = WAFFLE_DL_OPENGL_ES2;
+    const int32_t count = sizeof(names) / sizeof(names[0]);
+
+    struct waffle_display *dpy = NULL;
+    struct waffle_config *config = NULL;
+    struct waffle_window *window = NULL;
+    struct waffle_context *ctx = NULL;
+    struct waffle_symbol_cache_stats before, after;
+    void *syms[4];
+    void *clear;
+
+    ASSERT_TRUE(dpy = waffle_display_connect(NULL));
+
+    config = waffle_config_choose(dpy, config_attrib_list);
+    if (!config) {
+        if (waffle_error_get_code() == WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM)
+            TEST_SKIP();
+        else
+            TEST_FAIL();
+    }
+
+    // Some platforms resolve functions only for the current context.
+    ASSERT_TRUE(window = waffle_window_create(config, WINDOW_WIDTH,
+                                              WINDOW_HEIGHT));
+    ASSERT_TRUE(ctx = waffle_context_create(config, NULL));
+    ASSERT_TRUE(waffle_make_current(dpy, window, ctx));
+
+    // Put glClear in the cache.
+    if (use_dl)
+        ASSERT_TRUE(clear = waffle_dl_sym(dl, "glClear"));
+    else
+        ASSERT_TRUE(clear = waffle_get_proc_address("glClear"));
+
+    for (int pass = 0; pass < 2; ++pass) {
+        int32_t found;
+
+        // Stale values must be overwritten, not treated as resolved.
+        for (int32_t i = 0; i < count; ++i)
+            syms[i] = (void *) &syms;
+
+        ASSERT_TRUE(waffle_get_symbol_cache_stats(&before));
+        if (use_dl)
+            found = waffle_dl_sym_many(dl, count, names, syms);
+        else
+            found = waffle_get_proc_address_many(count, names, syms);
+        ASSERT_TRUE(waffle_get_symbol_cache_stats(&after));
+
+        ASSERT_TRUE(found == 2);
+        ASSERT_TRUE(waffle_error_get_code() == WAFFLE_NO_ERROR);
+        ASSERT_TRUE(syms[0] == clear);
+        ASSERT_TRUE(syms[1] == NULL);
+        ASSERT_TRUE(syms[2] == NULL);
+        ASSERT_TRUE(syms[3] != NULL);
+
+        // Each name is looked up in the cache once. The null name and the
+        // missing symbol always miss, and misses are not cached. glFlush
+        // misses on the first pass unless an earlier test looked it up.
+        ASSERT_TRUE(after.hits + after.misses ==
+                    before.hits + before.misses + count);
+        if (pass == 0) {
+            ASSERT_TRUE(after.hits >= before.hits + 1);
+        } else {
+            ASSERT_TRUE(after.hits == before.hits + 2);
+            ASSERT_TRUE(after.entries == before.entries);
+        }
+    }
+
+    // An empty batch finds nothing and needs no arrays.
+    if (use_dl)
+        ASSERT_TRUE(waffle_dl_sym_many(dl, 0, NULL, NULL) == 0);
+    else
+        ASSERT_TRUE(waffle_get_proc_address_many(0, NULL, NULL) == 0);
+
+    // Teardown.
+    ABORT_IF(!waffle_make_current(dpy, NULL, NULL));
+    ASSERT_TRUE(waffle_window_destroy(window));
+    ASSERT_TRUE(waffle_context_destroy(ctx));
+    ASSERT_TRUE(waffle_config_destroy(config));
+    ASSERT_TRUE(waffle_display_disconnect(dpy));
+}
+
 //
 // List of tests common to all platforms.
 //
@@ -420,15 +643,48 @@ TEST(gl_basic, all_gl21_fwdcompat_bad_attribute)
 
 
 //
-// List of linux (glx, wayland and x11_egl) and windows (wgl) specific tests.
+// List of linux (glx, wayland, x11_egl, surfaceless_egl and egl_device) and windows (wgl)
+// specific tests.
 //
-#if defined(WAFFLE_HAS_GLX) || defined(WAFFLE_HAS_WAYLAND) || defined(WAFFLE_HAS_X11_EGL) || defined(WAFFLE_HAS_WGL)
+#if defined(WAFFLE_HAS_GLX) || defined(WAFFLE_HAS_WAYLAND) || defined(WAFFLE_HAS_X11_EGL) || defined(WAFFLE_HAS_SURFACELESS_EGL) || defined(WAFFLE_HAS_EGL_DEVICE) || defined(WAFFLE_HAS_WGL)
 TEST(gl_basic, all_but_cgl_gl_debug)
 {
     gl_basic_draw(.api=WAFFLE_CONTEXT_OPENGL,
                   .debug=true);
 }
 
+TEST(gl_basic, all_but_cgl_gl_offscreen)
+{
+    gl_basic_draw(.api=WAFFLE_CONTEXT_OPENGL,
+                  .offscreen=true);
+}
+
+TEST(gl_basic, all_but_cgl_gles2_offscreen)
+{
+    gl_basic_draw(.api=WAFFLE_CONTEXT_OPENGL_ES2,
+                  .offscreen=true);
+}
+
+TEST(gl_basic, all_but_cgl_make_current_elision)
+{
+    gl_basic_make_current(true);
+}
+
+TEST(gl_basic, all_but_cgl_make_current_no_elision)
+{
+    gl_basic_make_current(false);
+}
+
+TEST(gl_basic, all_but_cgl_dl_sym_many)
+{
+    gl_basic_sym_many(true);
+}
+
+TEST(gl_basic, all_but_cgl_get_proc_address_many)
+{
+    gl_basic_sym_many(false);
+}
+
 TEST(gl_basic, all_but_cgl_gl_fwdcompat_bad_attribute)
 {
     gl_basic_draw(.api=WAFFLE_CONTEXT_OPENGL,
@@ -831,6 +1087,7 @@ testsuite_glx(void)
     TEST_RUN2(gl_basic, glx_gl_rgb, all_gl_rgb);
     TEST_RUN2(gl_basic, glx_gl_rgba, all_gl_rgb);
     TEST_RUN2(gl_basic, glx_gl_debug, all_but_cgl_gl_debug);
+    TEST_RUN2(gl_basic, glx_gl_offscreen, all_but_cgl_gl_offscreen);
     TEST_RUN2(gl_basic, glx_gl_fwdcompat_bad_attribute, all_but_cgl_gl_fwdcompat_bad_attribute);
 
     TEST_RUN2(gl_basic, glx_gl10, all_gl10);
@@ -875,12 +1132,16 @@ testsuite_glx(void)
     TEST_RUN2(gl_basic, glx_gles2_fwdcompat_bad_attribute, all_but_cgl_gles2_fwdcompat_bad_attribute);
 
     TEST_RUN2(gl_basic, glx_gles20, all_but_cgl_gles20);
+    TEST_RUN2(gl_basic, glx_gles2_offscreen, all_but_cgl_gles2_offscreen);
 
     TEST_RUN2(gl_basic, glx_gles3_rgb, all_but_cgl_gles3_rgb);
     TEST_RUN2(gl_basic, glx_gles3_rgba, all_but_cgl_gles3_rgba);
     TEST_RUN2(gl_basic, glx_gles3_fwdcompat_bad_attribute, all_but_cgl_gles3_fwdcompat_bad_attribute);
 
     TEST_RUN2(gl_basic, glx_gles30, all_but_cgl_gles30);
+
+    TEST_RUN2(gl_basic, glx_dl_sym_many, all_but_cgl_dl_sym_many);
+    TEST_RUN2(gl_basic, glx_get_proc_address_many, all_but_cgl_get_proc_address_many);
 }
 #endif // WAFFLE_HAS_GLX
 
@@ -899,6 +1160,7 @@ testsuite_wayland(void)
     TEST_RUN2(gl_basic, wayland_gl_rgba, all_gl_rgba);
 
     TEST_RUN2(gl_basic, wayland_gl_debug, all_but_cgl_gl_debug);
+    TEST_RUN2(gl_basic, wayland_gl_offscreen, all_but_cgl_gl_offscreen);
     TEST_RUN2(gl_basic, wayland_gl_fwdcompat_bad_attribute, all_but_cgl_gl_fwdcompat_bad_attribute);
 
     TEST_RUN2(gl_basic, wayland_gl10, all_gl10);
@@ -943,12 +1205,16 @@ testsuite_wayland(void)
     TEST_RUN2(gl_basic, wayland_gles1_fwdcompat_bad_attribute, all_but_cgl_gles1_fwdcompat_bad_attribute);
 
     TEST_RUN2(gl_basic, wayland_gles20, all_but_cgl_gles20);
+    TEST_RUN2(gl_basic, wayland_gles2_offscreen, all_but_cgl_gles2_offscreen);
 
     TEST_RUN2(gl_basic, wayland_gles3_rgb, all_but_cgl_gles3_rgb);
     TEST_RUN2(gl_basic, wayland_gles3_rgba, all_but_cgl_gles3_rgba);
     TEST_RUN2(gl_basic, wayland_gles3_fwdcompat_bad_attribute, all_but_cgl_gles3_fwdcompat_bad_attribute);
 
     TEST_RUN2(gl_basic, wayland_gles30, all_but_cgl_gles30);
+
+    TEST_RUN2(gl_basic, wayland_dl_sym_many, all_but_cgl_dl_sym_many);
+    TEST_RUN2(gl_basic, wayland_get_proc_address_many, all_but_cgl_get_proc_address_many);
 }
 #endif // WAFFLE_HAS_WAYLAND
 
@@ -966,6 +1232,7 @@ testsuite_x11_egl(void)
     TEST_RUN2(gl_basic, x11_egl_gl_rgb, all_gl_rgb);
     TEST_RUN2(gl_basic, x11_egl_gl_rgba, all_gl_rgba);
     TEST_RUN2(gl_basic, x11_egl_gl_debug, all_but_cgl_gl_debug);
+    TEST_RUN2(gl_basic, x11_egl_gl_offscreen, all_but_cgl_gl_offscreen);
     TEST_RUN2(gl_basic, x11_egl_gl_fwdcompat_bad_attribute, all_but_cgl_gl_fwdcompat_bad_attribute);
 
     TEST_RUN2(gl_basic, x11_egl_gl10, all_gl10);
@@ -1010,15 +1277,192 @@ testsuite_x11_egl(void)
     TEST_RUN2(gl_basic, x11_egl_gles2_fwdcompat_bad_attribute, all_but_cgl_gles2_fwdcompat_bad_attribute);
 
     TEST_RUN2(gl_basic, x11_egl_gles20, all_but_cgl_gles20);
+    TEST_RUN2(gl_basic, x11_egl_gles2_offscreen, all_but_cgl_gles2_offscreen);
 
     TEST_RUN2(gl_basic, x11_egl_gles3_rgb, all_but_cgl_gles3_rgb);
     TEST_RUN2(gl_basic, x11_egl_gles3_rgba, all_but_cgl_gles3_rgba);
     TEST_RUN2(gl_basic, x11_egl_gles3_fwdcompat_bad_attribute, all_but_cgl_gles3_fwdcompat_bad_attribute);
 
     TEST_RUN2(gl_basic, x11_egl_gles30, all_but_cgl_gles30);
+
+    TEST_RUN2(gl_basic, x11_egl_dl_sym_many, all_but_cgl_dl_sym_many);
+    TEST_RUN2(gl_basic, x11_egl_get_proc_address_many, all_but_cgl_get_proc_address_many);
 }
 #endif // WAFFLE_HAS_X11_EGL
 
+#ifdef WAFFLE_HAS_SURFACELESS_EGL
+TEST(gl_basic, surfaceless_egl_init)
+{
+    gl_basic_init(WAFFLE_PLATFORM_SURFACELESS_EGL);
+}
+
+TEST(gl_basic, surfaceless_egl_init_no_elision)
+{
+    gl_basic_init_no_elision(WAFFLE_PLATFORM_SURFACELESS_EGL);
+}
+
+static void
+testsuite_surfaceless_egl(void)
+{
+    TEST_RUN(gl_basic, surfaceless_egl_init);
+
+    TEST_RUN2(gl_basic, surfaceless_egl_gl_rgb, all_gl_rgb);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl_rgba, all_gl_rgba);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl_debug, all_but_cgl_gl_debug);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl_offscreen, all_but_cgl_gl_offscreen);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl_fwdcompat_bad_attribute, all_but_cgl_gl_fwdcompat_bad_attribute);
+
+    TEST_RUN2(gl_basic, surfaceless_egl_gl10, all_gl10);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl11, all_gl11);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl12, all_gl12);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl13, all_gl13);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl14, all_gl14);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl15, all_gl15);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl20, all_gl20);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl21, all_gl21);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl21_fwdcompat_bad_attribute, all_gl21_fwdcompat_bad_attribute);
+
+    TEST_RUN2(gl_basic, surfaceless_egl_gl30, all_but_cgl_gl30);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl30_fwdcompat, all_but_cgl_gl30_fwdcompat);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl31, all_but_cgl_gl31);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl31_fwdcompat, all_but_cgl_gl31_fwdcompat);
+
+    TEST_RUN2(gl_basic, surfaceless_egl_gl32_core, all_but_cgl_gl32_core);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl32_core_fwdcompat, all_but_cgl_gl32_core_fwdcompat);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl33_core, all_but_cgl_gl33_core);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl40_core, all_but_cgl_gl40_core);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl41_core, all_but_cgl_gl41_core);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl42_core, all_but_cgl_gl42_core);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl43_core, all_but_cgl_gl43_core);
+
+    TEST_RUN2(gl_basic, surfaceless_egl_gl32_compat, all_but_cgl_gl32_compat);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl33_compat, all_but_cgl_gl33_compat);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl40_compat, all_but_cgl_gl40_compat);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl41_compat, all_but_cgl_gl41_compat);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl42_compat, all_but_cgl_gl42_compat);
+    TEST_RUN2(gl_basic, surfaceless_egl_gl43_compat, all_but_cgl_gl43_compat);
+
+    TEST_RUN2(gl_basic, surfaceless_egl_gles1_rgb, all_but_cgl_gles1_rgb);
+    TEST_RUN2(gl_basic, surfaceless_egl_gles1_rgba, all_but_cgl_gles1_rgba);
+    TEST_RUN2(gl_basic, surfaceless_egl_gles1_fwdcompat_bad_attribute, all_but_cgl_gles1_fwdcompat_bad_attribute);
+
+    TEST_RUN2(gl_basic, surfaceless_egl_gles10, all_but_cgl_gles10);
+    TEST_RUN2(gl_basic, surfaceless_egl_gles11, all_but_cgl_gles11);
+
+    TEST_RUN2(gl_basic, surfaceless_egl_gles2_rgb, all_but_cgl_gles2_rgb);
+    TEST_RUN2(gl_basic, surfaceless_egl_gles2_rgba, all_but_cgl_gles2_rgba);
+    TEST_RUN2(gl_basic, surfaceless_egl_gles2_fwdcompat_bad_attribute, all_but_cgl_gles2_fwdcompat_bad_attribute);
+
+    TEST_RUN2(gl_basic, surfaceless_egl_gles20, all_but_cgl_gles20);
+    TEST_RUN2(gl_basic, surfaceless_egl_gles2_offscreen, all_but_cgl_gles2_offscreen);
+
+    TEST_RUN2(gl_basic, surfaceless_egl_gles3_rgb, all_but_cgl_gles3_rgb);
+    TEST_RUN2(gl_basic, surfaceless_egl_gles3_rgba, all_but_cgl_gles3_rgba);
+    TEST_RUN2(gl_basic, surfaceless_egl_gles3_fwdcompat_bad_attribute, all_but_cgl_gles3_fwdcompat_bad_attribute);
+
+    TEST_RUN2(gl_basic, surfaceless_egl_gles30, all_but_cgl_gles30);
+
+    TEST_RUN2(gl_basic, surfaceless_egl_dl_sym_many, all_but_cgl_dl_sym_many);
+    TEST_RUN2(gl_basic, surfaceless_egl_get_proc_address_many, all_but_cgl_get_proc_address_many);
+
+    TEST_RUN2(gl_basic, surfaceless_egl_make_current_elision, all_but_cgl_make_current_elision);
+    TEST_RUN(gl_basic, surfaceless_egl_init_no_elision);
+    TEST_RUN2(gl_basic, surfaceless_egl_make_current_no_elision, all_but_cgl_make_current_no_elision);
+}
+#endif // WAFFLE_HAS_SURFACELESS_EGL
+
+#ifdef WAFFLE_HAS_EGL_DEVICE
+TEST(gl_basic, egl_device_init)
+{
+    gl_basic_init(WAFFLE_PLATFORM_EGL_DEVICE);
+}
+
+TEST(gl_basic, egl_device_init_no_elision)
+{
+    gl_basic_init_no_elision(WAFFLE_PLATFORM_EGL_DEVICE);
+}
+
+TEST(gl_basic, egl_device_enumerate)
+{
+    int32_t num_devices = waffle_enumerate_devices();
+    ASSERT_TRUE(num_devices >= 1);
+    ASSERT_TRUE(waffle_device_query_string(0, WAFFLE_DEVICE_EXTENSIONS) != NULL);
+
+    ASSERT_TRUE(waffle_device_query_string(num_devices, WAFFLE_DEVICE_EXTENSIONS) == NULL);
+    ASSERT_TRUE(waffle_error_get_code() == WAFFLE_ERROR_BAD_PARAMETER);
+}
+
+static void
+testsuite_egl_device(void)
+{
+    TEST_RUN(gl_basic, egl_device_init);
+    TEST_RUN(gl_basic, egl_device_enumerate);
+
+    TEST_RUN2(gl_basic, egl_device_gl_rgb, all_gl_rgb);
+    TEST_RUN2(gl_basic, egl_device_gl_rgba, all_gl_rgba);
+    TEST_RUN2(gl_basic, egl_device_gl_debug, all_but_cgl_gl_debug);
+    TEST_RUN2(gl_basic, egl_device_gl_offscreen, all_but_cgl_gl_offscreen);
+    TEST_RUN2(gl_basic, egl_device_gl_fwdcompat_bad_attribute, all_but_cgl_gl_fwdcompat_bad_attribute);
+
+    TEST_RUN2(gl_basic, egl_device_gl10, all_gl10);
+    TEST_RUN2(gl_basic, egl_device_gl11, all_gl11);
+    TEST_RUN2(gl_basic, egl_device_gl12, all_gl12);
+    TEST_RUN2(gl_basic, egl_device_gl13, all_gl13);
+    TEST_RUN2(gl_basic, egl_device_gl14, all_gl14);
+    TEST_RUN2(gl_basic, egl_device_gl15, all_gl15);
+    TEST_RUN2(gl_basic, egl_device_gl20, all_gl20);
+    TEST_RUN2(gl_basic, egl_device_gl21, all_gl21);
+    TEST_RUN2(gl_basic, egl_device_gl21_fwdcompat_bad_attribute, all_gl21_fwdcompat_bad_attribute);
+
+    TEST_RUN2(gl_basic, egl_device_gl30, all_but_cgl_gl30);
+    TEST_RUN2(gl_basic, egl_device_gl30_fwdcompat, all_but_cgl_gl30_fwdcompat);
+    TEST_RUN2(gl_basic, egl_device_gl31, all_but_cgl_gl31);
+    TEST_RUN2(gl_basic, egl_device_gl31_fwdcompat, all_but_cgl_gl31_fwdcompat);
+
+    TEST_RUN2(gl_basic, egl_device_gl32_core, all_but_cgl_gl32_core);
+    TEST_RUN2(gl_basic, egl_device_gl32_core_fwdcompat, all_but_cgl_gl32_core_fwdcompat);
+    TEST_RUN2(gl_basic, egl_device_gl33_core, all_but_cgl_gl33_core);
+    TEST_RUN2(gl_basic, egl_device_gl40_core, all_but_cgl_gl40_core);
+    TEST_RUN2(gl_basic, egl_device_gl41_core, all_but_cgl_gl41_core);
+    TEST_RUN2(gl_basic, egl_device_gl42_core, all_but_cgl_gl42_core);
+    TEST_RUN2(gl_basic, egl_device_gl43_core, all_but_cgl_gl43_core);
+
+    TEST_RUN2(gl_basic, egl_device_gl32_compat, all_but_cgl_gl32_compat);
+    TEST_RUN2(gl_basic, egl_device_gl33_compat, all_but_cgl_gl33_compat);
+    TEST_RUN2(gl_basic, egl_device_gl40_compat, all_but_cgl_gl40_compat);
+    TEST_RUN2(gl_basic, egl_device_gl41_compat, all_but_cgl_gl41_compat);
+    TEST_RUN2(gl_basic, egl_device_gl42_compat, all_but_cgl_gl42_compat);
+    TEST_RUN2(gl_basic, egl_device_gl43_compat, all_but_cgl_gl43_compat);
+
+    TEST_RUN2(gl_basic, egl_device_gles1_rgb, all_but_cgl_gles1_rgb);
+    TEST_RUN2(gl_basic, egl_device_gles1_rgba, all_but_cgl_gles1_rgba);
+    TEST_RUN2(gl_basic, egl_device_gles1_fwdcompat_bad_attribute, all_but_cgl_gles1_fwdcompat_bad_attribute);
+
+    TEST_RUN2(gl_basic, egl_device_gles10, all_but_cgl_gles10);
+    TEST_RUN2(gl_basic, egl_device_gles11, all_but_cgl_gles11);
+
+    TEST_RUN2(gl_basic, egl_device_gles2_rgb, all_but_cgl_gles2_rgb);
+    TEST_RUN2(gl_basic, egl_device_gles2_rgba, all_but_cgl_gles2_rgba);
+    TEST_RUN2(gl_basic, egl_device_gles2_fwdcompat_bad_attribute, all_but_cgl_gles2_fwdcompat_bad_attribute);
+
+    TEST_RUN2(gl_basic, egl_device_gles20, all_but_cgl_gles20);
+    TEST_RUN2(gl_basic, egl_device_gles2_offscreen, all_but_cgl_gles2_offscreen);
+
+    TEST_RUN2(gl_basic, egl_device_gles3_rgb, all_but_cgl_gles3_rgb);
+    TEST_RUN2(gl_basic, egl_device_gles3_rgba, all_but_cgl_gles3_rgba);
+    TEST_RUN2(gl_basic, egl_device_gles3_fwdcompat_bad_attribute, all_but_cgl_gles3_fwdcompat_bad_attribute);
+
+    TEST_RUN2(gl_basic, egl_device_gles30, all_but_cgl_gles30);
+
+    TEST_RUN2(gl_basic, egl_device_dl_sym_many, all_but_cgl_dl_sym_many);
+    TEST_RUN2(gl_basic, egl_device_get_proc_address_many, all_but_cgl_get_proc_address_many);
+
+    TEST_RUN2(gl_basic, egl_device_make_current_elision, all_but_cgl_make_current_elision);
+    TEST_RUN(gl_basic, egl_device_init_no_elision);
+    TEST_RUN2(gl_basic, egl_device_make_current_no_elision, all_but_cgl_make_current_no_elision);
+}
+#endif // WAFFLE_HAS_EGL_DEVICE
+
 #ifdef WAFFLE_HAS_WGL
 TEST(gl_basic, wgl_init)
 {
@@ -1217,6 +1661,12 @@ main(int argc, char *argv[])
 #ifdef WAFFLE_HAS_X11_EGL
     run_testsuite(testsuite_x11_egl);
 #endif
+#ifdef WAFFLE_HAS_SURFACELESS_EGL
+    run_testsuite(testsuite_surfaceless_egl);
+#endif
+#ifdef WAFFLE_HAS_EGL_DEVICE
+    run_testsuite(testsuite_egl_device);
+#endif
 #ifdef WAFFLE_HAS_WGL
     run_testsuite(testsuite_wgl);
 #endif